@@ -0,0 +1,250 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../utilities/types.h"
+
+namespace ao::core {
+    /**
+     * @brief Get a new slot generation, generations are odd and process-wide unique (until they wrap),
+     * so that a handle of a table is never valid in another one
+     *
+     * @return u32 Generation
+     */
+    inline u32 nextSlotGeneration() {
+        static std::atomic<u32> generation(1);
+
+        return generation.fetch_add(2);
+    }
+
+    /**
+     * @brief Table of values addressed by handles (slot index + generation).
+     * Slots live in pages that never move, so lookups are lock-free and O(1), insertions/removals lock a mutex but are O(1) too.
+     * A value mustn't be erased while another thread uses it
+     *
+     * @tparam T Value type
+     * @tparam PageSize Count of slots in a page
+     * @tparam MaxPages Maximal count of pages
+     */
+    template<class T, size_t PageSize = 1024, size_t MaxPages = 4096>
+    class SlotTable {
+       public:
+        using Handle = u64;
+
+        static constexpr Handle InvalidHandle = 0;
+
+        /**
+         * @brief Construct a new SlotTable object
+         *
+         */
+        SlotTable() : count(0), used(0) {
+            for (auto& page : this->pages) {
+                page.store(nullptr, std::memory_order_relaxed);
+            }
+        }
+        SlotTable(SlotTable const&) = delete;
+
+        /**
+         * @brief Destroy the SlotTable object
+         *
+         */
+        virtual ~SlotTable() {
+            for (auto& page : this->pages) {
+                delete[] page.load(std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Insert a value
+         *
+         * @param value Value
+         * @return Handle Handle
+         */
+        Handle insert(T value) {
+            std::lock_guard lock(this->mutex);
+
+            // Find a free slot
+            u32 index;
+            if (!this->free_slots.empty()) {
+                index = this->free_slots.back();
+                this->free_slots.pop_back();
+            } else {
+                if (this->used == PageSize * MaxPages) {
+                    throw std::length_error("SlotTable is full");
+                }
+                index = this->used;
+
+                // Create page
+                if (index % PageSize == 0) {
+                    this->pages[index / PageSize].store(new Slot[PageSize], std::memory_order_release);
+                }
+                this->used.store(index + 1, std::memory_order_release);
+            }
+
+            // Publish value
+            auto& slot = this->slot(index);
+            u32 generation = nextSlotGeneration();
+            slot.value = std::move(value);
+            slot.generation.store(generation, std::memory_order_release);
+            this->count++;
+
+            return (static_cast<Handle>(generation) << 32) | index;
+        }
+
+        /**
+         * @brief Erase value
+         *
+         * @param handle Handle
+         * @return true Value is erased
+         * @return false Handle isn't valid
+         */
+        bool erase(Handle handle) {
+            return this->extract(handle).has_value();
+        }
+
+        /**
+         * @brief Remove value and return it. Handle is invalidated atomically, so when several threads extract the same handle
+         * only one of them gets the value
+         *
+         * @param handle Handle
+         * @return std::optional<T> Value, std::nullopt if handle isn't valid
+         */
+        std::optional<T> extract(Handle handle) {
+            u32 index = static_cast<u32>(handle);
+            u32 generation = static_cast<u32>(handle >> 32);
+
+            if (generation == 0 || index >= this->used.load(std::memory_order_acquire)) {
+                return std::nullopt;
+            }
+
+            // Invalidate handle
+            auto& slot = this->slot(index);
+            if (!slot.generation.compare_exchange_strong(generation, 0, std::memory_order_acq_rel)) {
+                return std::nullopt;
+            }
+
+            // Release slot
+            std::lock_guard lock(this->mutex);
+            std::optional<T> value(std::move(slot.value));
+            slot.value = T();
+            this->free_slots.push_back(index);
+            this->count--;
+
+            return value;
+        }
+
+        /**
+         * @brief Check if handle is valid
+         *
+         * @param handle Handle
+         * @return true Handle is valid
+         * @return false Handle isn't valid
+         */
+        bool contains(Handle handle) const {
+            u32 index = static_cast<u32>(handle);
+            u32 generation = static_cast<u32>(handle >> 32);
+
+            if (generation == 0 || index >= this->used.load(std::memory_order_acquire)) {
+                return false;
+            }
+            return this->slot(index).generation.load(std::memory_order_acquire) == generation;
+        }
+
+        /**
+         * @brief Get value
+         *
+         * @param handle Handle
+         * @return T* Value, nullptr if handle isn't valid
+         */
+        T* get(Handle handle) {
+            return this->contains(handle) ? &this->slot(static_cast<u32>(handle)).value : nullptr;
+        }
+
+        /**
+         * @brief Get value
+         *
+         * @param handle Handle
+         * @return T const* Value, nullptr if handle isn't valid
+         */
+        T const* get(Handle handle) const {
+            return this->contains(handle) ? &this->slot(static_cast<u32>(handle)).value : nullptr;
+        }
+
+        /**
+         * @brief Call {function} with handle and value of each slot in use, values mustn't be erased meanwhile
+         *
+         * @tparam Function Function type
+         * @param function Function
+         */
+        template<class Function>
+        void forEach(Function function) {
+            u32 used = this->used.load(std::memory_order_acquire);
+
+            for (u32 index = 0; index < used; index++) {
+                auto& slot = this->slot(index);
+                u32 generation = slot.generation.load(std::memory_order_acquire);
+
+                if (generation != 0) {
+                    function((static_cast<Handle>(generation) << 32) | index, slot.value);
+                }
+            }
+        }
+
+        /**
+         * @brief Get count of values
+         *
+         * @return size_t Count
+         */
+        size_t size() const {
+            return this->count;
+        }
+
+        /**
+         * @brief Check if table is empty
+         *
+         * @return true Table is empty
+         * @return false Table isn't empty
+         */
+        bool empty() const {
+            return this->count == 0;
+        }
+
+        SlotTable& operator=(SlotTable const&) = delete;
+
+       protected:
+        /**
+         * @brief Slot, generation is 0 when it's free
+         *
+         */
+        struct Slot {
+            std::atomic<u32> generation{0};
+            T value;
+        };
+
+        std::array<std::atomic<Slot*>, MaxPages> pages;
+        std::vector<u32> free_slots;
+        std::atomic<size_t> count;
+        std::atomic<u32> used;
+        std::mutex mutex;
+
+        /**
+         * @brief Get slot at {index}
+         *
+         * @param index Index
+         * @return Slot& Slot
+         */
+        Slot& slot(u32 index) const {
+            return this->pages[index / PageSize].load(std::memory_order_acquire)[index % PageSize];
+        }
+    };
+}  // namespace ao::core
@@ -0,0 +1,223 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../utilities/types.h"
+
+namespace ao::core {
+    class JobSystem;
+
+    /**
+     * @brief Counter of unfinished jobs, jobs depending on it are scheduled once it reaches zero.
+     * First exception thrown by its jobs is kept and rethrown by JobSystem::wait()
+     *
+     */
+    class JobCounter {
+       public:
+        /**
+         * @brief Construct a new JobCounter object
+         *
+         */
+        JobCounter() : value(0) {}
+        JobCounter(JobCounter const&) = delete;
+
+        /**
+         * @brief Destroy the JobCounter object
+         *
+         */
+        virtual ~JobCounter() = default;
+
+        /**
+         * @brief Get count of unfinished jobs
+         *
+         * @return size_t Count
+         */
+        size_t pending() const {
+            return this->value.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Check if all jobs are finished
+         *
+         * @return true Jobs are finished
+         * @return false Some jobs aren't finished
+         */
+        bool done() const {
+            return this->pending() == 0;
+        }
+
+        JobCounter& operator=(JobCounter const&) = delete;
+
+       protected:
+        friend class JobSystem;
+
+        std::vector<std::pair<std::function<void()>, std::shared_ptr<JobCounter>>> continuations;
+        std::atomic<size_t> value;
+        std::exception_ptr error;
+        std::mutex mutex;
+    };
+
+    /**
+     * @brief Work-stealing job system: each worker owns a deque, it pops its own jobs in LIFO order (cache-friendly)
+     * and steals jobs of other workers in FIFO order when it's empty. Threads waiting a counter execute jobs meanwhile,
+     * so jobs can schedule and wait other jobs without deadlocking the pool
+     *
+     */
+    class JobSystem {
+       public:
+        using Job = std::function<void()>;
+
+        /**
+         * @brief Construct a new JobSystem object
+         *
+         * @param threads Count of workers, 0 to use a worker per core (minus the calling thread)
+         */
+        explicit JobSystem(u32 threads = 0);
+        JobSystem(JobSystem const&) = delete;
+
+        /**
+         * @brief Destroy the JobSystem object, scheduled jobs are executed before workers stop
+         *
+         */
+        virtual ~JobSystem();
+
+        /**
+         * @brief Get job system shared by the whole process, sharing a pool avoids oversubscription
+         *
+         * @return std::shared_ptr<JobSystem> Job system
+         */
+        static std::shared_ptr<JobSystem> Shared();
+
+        /**
+         * @brief Schedule a job
+         *
+         * @param job Job
+         * @param counter Counter incremented until job is finished, a new one is created if it's nullptr
+         * @param dependency Counter that must reach zero before job starts
+         * @return std::shared_ptr<JobCounter> Counter
+         */
+        std::shared_ptr<JobCounter> schedule(Job job, std::shared_ptr<JobCounter> counter = nullptr,
+                                             std::shared_ptr<JobCounter> const& dependency = nullptr);
+
+        /**
+         * @brief Wait until counter reaches zero, calling thread executes jobs meanwhile and sleeps while none is queued
+         *
+         * @param counter Counter
+         */
+        void wait(std::shared_ptr<JobCounter> const& counter);
+
+        /**
+         * @brief Call {function} on chunks [begin, end) of range [{begin}, {end}) in parallel, then wait them
+         *
+         * @tparam Function Function type, void(size_t begin, size_t end)
+         * @param begin Range's begin
+         * @param end Range's end
+         * @param function Function
+         * @param grain Count of indices in a chunk, 0 to split range into a few chunks per thread
+         */
+        template<class Function>
+        void parallelFor(size_t begin, size_t end, Function const& function, size_t grain = 0) {
+            if (begin >= end) {
+                return;
+            }
+
+            // Define chunks
+            size_t threads = this->size() + 1;
+            if (grain == 0) {
+                grain = std::max<size_t>((end - begin + 4 * threads - 1) / (4 * threads), 1);
+            }
+
+            // Schedule chunks
+            auto counter = std::make_shared<JobCounter>();
+            for (size_t first = begin; first < end; first += std::min(grain, end - first)) {
+                size_t last = first + std::min(grain, end - first);
+
+                this->schedule([&function, first, last]() { function(first, last); }, counter);
+            }
+            this->wait(counter);
+        }
+
+        /**
+         * @brief Get count of workers
+         *
+         * @return size_t Count
+         */
+        size_t size() const {
+            return this->threads.size();
+        }
+
+        JobSystem& operator=(JobSystem const&) = delete;
+
+       protected:
+        /**
+         * @brief Job and the counter it decrements
+         *
+         */
+        struct Task {
+            Job job;
+            std::shared_ptr<JobCounter> counter;
+        };
+
+        /**
+         * @brief Worker's deque
+         *
+         */
+        struct Queue {
+            std::deque<Task> tasks;
+            std::mutex mutex;
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::vector<std::thread> threads;
+
+        std::condition_variable condition;
+        std::atomic<size_t> next_queue;
+        std::atomic<size_t> queued;
+        std::mutex mutex;
+        bool stop;
+
+        /**
+         * @brief Push a task into deque of current worker (or of a worker picked in round-robin from other threads)
+         *
+         * @param task Task
+         */
+        void push(Task task);
+
+        /**
+         * @brief Pop a task from deque of current worker, otherwise steal it from another worker
+         *
+         * @param task Task
+         * @return true A task is popped
+         * @return false Deques are empty
+         */
+        bool pop(Task& task);
+
+        /**
+         * @brief Execute a task, then schedule jobs depending on its counter if it reaches zero
+         *
+         * @param task Task
+         */
+        void run(Task& task);
+
+        /**
+         * @brief Worker's loop
+         *
+         * @param index Worker's index
+         */
+        void work(size_t index);
+    };
+}  // namespace ao::core
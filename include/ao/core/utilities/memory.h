@@ -5,6 +5,12 @@
 #pragma once
 
 #include <stdio.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <type_traits>
 
 namespace ao::core::utilities {
     /**
@@ -14,10 +20,99 @@ namespace ao::core::utilities {
      * @param alignment Alignment
      * @return size_t Aligned size
      */
-    inline size_t calculateAligmentSize(size_t size, size_t alignment = 0) {
+    constexpr size_t calculateAligmentSize(size_t size, size_t alignment = 0) {
         if (alignment > 0) {
             return (size + alignment - 1) & ~(alignment - 1);
         }
         return size;
     }
+
+    /**
+     * @brief Copy {count} contiguous elements of {source} into {destination}. A single memcpy is used if {destination} is contiguous too,
+     * otherwise elements are copied one by one
+     *
+     * @tparam T Element type
+     * @param destination Destination
+     * @param stride Stride of destination (in bytes)
+     * @param source Source
+     * @param count Count of elements
+     */
+    template<class T>
+    inline void stridedCopy(void* destination, size_t stride, T const* source, size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>, "Elements are copied with memcpy");
+
+        if (stride == sizeof(T)) {
+            std::memcpy(destination, source, sizeof(T) * count);
+            return;
+        }
+
+        auto to = static_cast<char*>(destination);
+        for (size_t i = 0; i < count; i++, to += stride) {
+            std::memcpy(to, source + i, sizeof(T));
+        }
+    }
+
+    /**
+     * @brief Copy {value} into {count} elements of {destination}. Pattern is repeated in a 4 KiB host chunk that is copied
+     * with memcpy, so that {destination} is written sequentially and never read (it can be write-combined)
+     *
+     * @tparam T Element type
+     * @param destination Destination
+     * @param stride Stride of destination (in bytes)
+     * @param value Value
+     * @param count Count of elements
+     */
+    template<class T>
+    inline void stridedFill(void* destination, size_t stride, T const& value, size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>, "Elements are copied with memcpy");
+        constexpr size_t ChunkSize = 4096;
+
+        // Element doesn't fit in chunk
+        if (stride > ChunkSize) {
+            for (size_t i = 0; i < count; i++) {
+                std::memcpy(static_cast<char*>(destination) + i * stride, &value, sizeof(T));
+            }
+            return;
+        }
+
+        // Repeat pattern in chunk (padding between elements is zeroed)
+        std::array<char, ChunkSize> chunk{};
+        size_t per_chunk = (std::min)(ChunkSize / stride, count);
+        for (size_t i = 0; i < per_chunk; i++) {
+            std::memcpy(chunk.data() + i * stride, &value, sizeof(T));
+        }
+
+        // Copy chunks, the last element's padding isn't written
+        auto to = static_cast<char*>(destination);
+        for (size_t i = 0; i < count; i += per_chunk) {
+            size_t elements = (std::min)(per_chunk, count - i);
+
+            std::memcpy(to + i * stride, chunk.data(), (elements - 1) * stride + sizeof(T));
+        }
+    }
+
+    /**
+     * @brief Add range [{begin}, {end}) to an interval set (begin -> end), overlapping or adjacent intervals are merged
+     *
+     * @tparam T Bound type
+     * @param ranges Interval set
+     * @param begin Range's begin
+     * @param end Range's end
+     */
+    template<class T>
+    inline void mergeRange(std::map<T, T>& ranges, T begin, T end) {
+        auto it = ranges.upper_bound(begin);
+
+        if (it != ranges.begin() && std::prev(it)->second >= begin) {
+            it = std::prev(it);
+            begin = it->first;
+            end = (std::max)(end, it->second);
+            it = ranges.erase(it);
+        }
+        while (it != ranges.end() && it->first <= end) {
+            end = (std::max)(end, it->second);
+            it = ranges.erase(it);
+        }
+        ranges[begin] = end;
+    }
 }  // namespace ao::core::utilities
\ No newline at end of file
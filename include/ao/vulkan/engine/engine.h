@@ -14,9 +14,12 @@
 
 #include "../container/pipeline_container.h"
 #include "../container/semaphore_container.h"
+#include "../memory/allocator/linear_allocator.h"
 #include "../utilities/vulkan.h"
 #include "../wrapper/device.h"
 #include "../wrapper/swapchain.h"
+#include "../wrapper/timeline_semaphore.h"
+#include "command_recorder.h"
 #include "settings.h"
 
 namespace ao::vulkan {
@@ -68,17 +71,53 @@ namespace ao::vulkan {
             return this->settings_;
         }
 
+        /**
+         * @brief Get current frame, per-frame resources (see PerFrame) must be rotated on it
+         *
+         * @return u32 Frame index
+         */
+        u32 currentFrame() const {
+            return this->current_frame;
+        }
+
+        /**
+         * @brief Get count of frames the CPU may prepare while GPU renders previous ones (settings::FramesInFlight, 2 by default).
+         * It doesn't depend on swapchain's image count
+         *
+         * @return u32 Count of frames
+         */
+        u32 framesInFlight() const {
+            return this->frames_in_flight;
+        }
+
+        /**
+         * @brief Get timeline semaphore of graphics queue (settings::TimelineSemaphores), other queues can wait its values
+         * to depend on a frame without extra semaphores
+         *
+         * @return TimelineSemaphore* Timeline semaphore, nullptr if frames are synchronized with fences
+         */
+        TimelineSemaphore* graphicsTimeline() const {
+            return this->timeline.get();
+        }
+
        protected:
         std::shared_ptr<EngineSettings> settings_;
         std::atomic_bool enforce_resize;
+        u32 frames_in_flight;
         u32 current_frame;
 
+        std::unique_ptr<CommandRecorder> command_recorder;
+        std::shared_ptr<LinearAllocator> frame_allocator;
         std::unique_ptr<SemaphoreContainer> semaphores;
         vk::DebugUtilsMessengerEXT debug_callBack;
         std::shared_ptr<vk::Instance> instance;
         std::shared_ptr<Swapchain> swapchain;
         std::shared_ptr<Device> device;
+        std::vector<vk::Fence> image_fences;
         std::vector<vk::Fence> fences;
+        std::unique_ptr<TimelineSemaphore> timeline;
+        std::vector<u64> image_values;
+        std::vector<u64> frame_values;
         PipelineContainer pipelines;
         vk::RenderPass render_pass;
 
@@ -107,6 +146,13 @@ namespace ao::vulkan {
          */
         virtual vk::RenderPass createRenderPass() = 0;
 
+        /**
+         * @brief Create swapchain object
+         *
+         * @return std::shared_ptr<Swapchain> Swapchain
+         */
+        virtual std::shared_ptr<Swapchain> createSwapchain();
+
         /**
          * @brief Re-create swapchain object
          *
@@ -120,11 +166,33 @@ namespace ao::vulkan {
         virtual void createSemaphores();
 
         /**
-         * @brief Create fences
+         * @brief Create a fence per frame in flight, swapchain's images are tracked by fence of the last frame that used them.
+         * With timeline semaphores, a single timeline semaphore replaces fences and frames/images are tracked by its values
          *
          */
         virtual void createFences();
 
+        /**
+         * @brief Wait until {frame} is rendered
+         *
+         * @param frame Frame index
+         */
+        virtual void waitFrame(u32 frame);
+
+        /**
+         * @brief Wait previous frame that used {image}, then mark it as used by current frame
+         *
+         * @param image Image index
+         */
+        virtual void waitImage(u32 image);
+
+        /**
+         * @brief Submit current frame's command buffers to graphics queue, so that waitFrame() can wait them
+         *
+         * @param submit_info Submit info
+         */
+        virtual void submitCommands(vk::SubmitInfo submit_info);
+
         /**
          * @brief Create vulkan objects (Pipelines, buffers...)
          *
@@ -202,6 +270,17 @@ namespace ao::vulkan {
          */
         virtual void updateCommandBuffers() = 0;
 
+        /**
+         * @brief Record {count} draws into swapchain's current command buffer with the command recorder (see settings::RecordingSlices):
+         * render pass is begun with secondary contents, {function} records slices of draws from several threads
+         * and primary command buffer executes them in order
+         *
+         * @param begin_info Render pass begin info
+         * @param count Count of draws
+         * @param function Record function
+         */
+        void recordParallel(vk::RenderPassBeginInfo const& begin_info, size_t count, CommandRecorder::RecordFunction const& function);
+
         /**
          * @brief Called before command buffers update
          *
@@ -0,0 +1,173 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#pragma once
+
+#include <ao/core/exception/exception.h>
+#include <ao/core/memory/ptr_iterator.hpp>
+#include <ao/core/utilities/memory.h>
+#include <fmt/format.h>
+
+#include "allocator/allocator.h"
+#include "buffer.h"
+
+namespace ao::vulkan {
+    /**
+     * @brief Vulkan buffer with array interface whose stride is known at compile time, element access isn't virtual.
+     * {Alignment} must be a multiple of allocator's alignment
+     *
+     * @tparam N Array's size
+     * @tparam T Type of elements
+     * @tparam Alignment Alignment of elements
+     */
+    template<size_t N, class T, size_t Alignment>
+    class AlignedArray : public Buffer {
+       public:
+        static constexpr size_t Stride = core::utilities::calculateAligmentSize(sizeof(T), Alignment);
+
+        /**
+         * @brief Construct a new AlignedArray object
+         *
+         * @param allocator Allocator
+         * @param usage Buffer usage
+         */
+        AlignedArray(std::shared_ptr<Allocator> allocator, vk::BufferUsageFlags usage = vk::BufferUsageFlags())
+            : Buffer(allocator, N * Stride, usage) {
+            // Check alignment
+            if (Stride % allocator->alignSize(1) != 0) {
+                throw core::Exception(fmt::format("Alignment {} isn't compatible with allocator's alignment {}", Alignment, allocator->alignSize(1)));
+            }
+        }
+
+        /**
+         * @brief Construct a new AlignedArray object
+         *
+         * @param value Value to copy in each element
+         * @param allocator Allocator
+         * @param usage Buffer usage
+         */
+        AlignedArray(T const& value, std::shared_ptr<Allocator> allocator, vk::BufferUsageFlags usage = vk::BufferUsageFlags())
+            : AlignedArray(allocator, usage) {
+            // Fill
+            for (size_t i = 0; i < N; i++) {
+                (*this)[i] = value;
+            }
+
+            // Notify
+            this->invalidateAll();
+        }
+
+        /**
+         * @brief Destroy the AlignedArray object
+         *
+         */
+        virtual ~AlignedArray() = default;
+
+        /**
+         * @brief Operator[]
+         *
+         * @param index Index
+         * @return T& Value
+         */
+        T& operator[](size_t index) {
+            return *reinterpret_cast<T*>(static_cast<char*>(*this->buffer_info->ptr) + index * Stride);
+        }
+
+        /**
+         * @brief Get a reference of object at index {index}
+         *
+         * @param index Index
+         * @return T& Value
+         */
+        T& at(size_t index) {
+            return (*this)[index];
+        }
+
+        /**
+         * @brief Get begin iterator
+         *
+         * @return core::PtrIterator<T> Iterator
+         */
+        core::PtrIterator<T> begin() {
+            return core::PtrIterator<T>(&(*this)[0], Stride);
+        }
+
+        /**
+         * @brief Get end iterator
+         *
+         * @return core::PtrIterator<T> Iterator
+         */
+        core::PtrIterator<T> end() {
+            return core::PtrIterator<T>(&(*this)[N], Stride);
+        }
+
+        /**
+         * @brief Get pointer to first element
+         *
+         * @return T* Pointer
+         */
+        T* data() {
+            return static_cast<T*>(*this->buffer_info->ptr);
+        }
+
+        /**
+         * @brief Check if elements are contiguous (stride is sizeof(T)), then data() can be used as a plain array
+         *
+         * @return true Elements are contiguous
+         * @return false Elements are strided
+         */
+        static constexpr bool contiguous() {
+            return Stride == sizeof(T);
+        }
+
+        /**
+         * @brief Get size
+         *
+         * @return size_t Size
+         */
+        constexpr size_t size() const {
+            return N;
+        }
+
+        /**
+         * @brief Get offset of object at index {index} in info().buffer, to bind it
+         *
+         * @param index Index
+         * @return vk::DeviceSize Offset
+         */
+        vk::DeviceSize offset(size_t index) const {
+            return this->buffer_info->offset + relativeOffset(index);
+        }
+
+        /**
+         * @brief Get offset of object at index {index} from start of allocation (info().ptr)
+         *
+         * @param index Index
+         * @return vk::DeviceSize Offset
+         */
+        static constexpr vk::DeviceSize relativeOffset(size_t index) {
+            return index * Stride;
+        }
+
+        /**
+         * @brief Invalidate {count} objects from {index}
+         *
+         * @param index Index
+         * @param count Count
+         */
+        void invalidate(size_t index, size_t count = 1) {
+            this->allocator_->invalidate(*this->buffer_info, relativeOffset(index), count * Stride);
+        }
+
+        /**
+         * @brief Mark {count} objects from {index} as dirty, they're invalidated by flush()
+         *
+         * @param index Index
+         * @param count Count
+         */
+        void markDirty(size_t index, size_t count = 1) {
+            Buffer::markDirty(relativeOffset(index), count * Stride);
+        }
+    };
+}  // namespace ao::vulkan
@@ -4,6 +4,13 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+
 #include <ao/core/utilities/optional.h>
 #include <vulkan/vulkan.hpp>
 
@@ -17,13 +24,17 @@ namespace ao::vulkan {
     class Allocator {
        public:
         /**
-         * @brief Buffer into
+         * @brief Buffer into, {handle} identifies allocation in its allocator (0 if allocator doesn't track allocations).
+         * {coherent} is true if writes through {ptr} are seen by device without invalidation
          *
          */
         struct BufferInfo {
             std::optional<void*> ptr;
+            vk::DeviceSize offset;
             vk::DeviceSize size;
             vk::Buffer buffer;
+            u64 handle = 0;
+            bool coherent = false;
 
             /**
              * @brief Construct a new BufferInfo object
@@ -31,9 +42,55 @@ namespace ao::vulkan {
              * @param size Size
              * @param buffer Buffer
              * @param ptr Pointer
+             * @param offset Offset in buffer
+             */
+            BufferInfo(vk::DeviceSize size = vk::DeviceSize(), vk::Buffer buffer = nullptr, std::optional<void*> ptr = std::nullopt,
+                       vk::DeviceSize offset = 0)
+                : size(size), buffer(buffer), ptr(ptr), offset(offset){};
+        };
+
+        /**
+         * @brief Memory heap's budget
+         *
+         */
+        struct HeapBudget {
+            vk::DeviceSize usage;
+            vk::DeviceSize budget;
+        };
+
+        /**
+         * @brief Memory statistics of a memory type, {free} counts free bytes in blocks that are sub-allocated
+         *
+         */
+        struct MemoryTypeStatistics {
+            size_t blocks = 0;
+            vk::DeviceSize memory = 0;
+            vk::DeviceSize free = 0;
+            vk::DeviceSize largest_free = 0;
+
+            /**
+             * @brief Get memory used
+             *
+             * @return vk::DeviceSize Memory size (in bytes)
              */
-            BufferInfo(vk::DeviceSize size = vk::DeviceSize(), vk::Buffer buffer = nullptr, std::optional<void*> ptr = std::nullopt)
-                : size(size), buffer(buffer), ptr(ptr){};
+            vk::DeviceSize used() const {
+                return this->memory - this->free;
+            }
+        };
+
+        /**
+         * @brief Allocator's statistics, histogram's bucket {i} counts allocations of [2^i, 2^(i+1)) bytes.
+         * {host_copies} counts host RAM used by copies of allocations that aren't Vulkan memory (DeviceAllocator with a staging ring)
+         *
+         */
+        struct Statistics {
+            static constexpr size_t HistogramSize = 32;
+
+            std::map<u32, MemoryTypeStatistics> memory_types;
+            std::array<size_t, HistogramSize> histogram{};
+            vk::DeviceSize allocated = 0;
+            vk::DeviceSize host_copies = 0;
+            size_t allocations = 0;
         };
 
         /**
@@ -41,7 +98,7 @@ namespace ao::vulkan {
          *
          * @param device Device
          */
-        Allocator(std::shared_ptr<Device> device) : device(device) {}
+        Allocator(std::shared_ptr<Device> device);
         Allocator(Allocator const&) = delete;
 
         /**
@@ -66,6 +123,16 @@ namespace ao::vulkan {
          */
         virtual void free(BufferInfo const& info) = 0;
 
+        /**
+         * @brief Copy first {size} bytes of {source} into {destination}.
+         * By default host memory is copied, allocators keeping data on device copy it there too
+         *
+         * @param source Source
+         * @param destination Destination
+         * @param size Size
+         */
+        virtual void copy(BufferInfo const& source, BufferInfo const& destination, vk::DeviceSize size);
+
         /**
          * @brief Align a size
          *
@@ -90,6 +157,14 @@ namespace ao::vulkan {
          */
         virtual void invalidate(BufferInfo const& info, vk::DeviceSize const& offset, vk::DeviceSize const& size) = 0;
 
+        /**
+         * @brief Notify allocator that several ranges of buffer were updated, by default each range is invalidated
+         *
+         * @param info Buffer info
+         * @param ranges Ranges (begin -> end)
+         */
+        virtual void invalidateRanges(BufferInfo const& info, std::map<vk::DeviceSize, vk::DeviceSize> const& ranges);
+
         /**
          * @brief Check if allocator owns given buffer
          *
@@ -99,9 +174,124 @@ namespace ao::vulkan {
          */
         virtual bool own(BufferInfo const& info) const = 0;
 
+        /**
+         * @brief Set callback called with new buffer & offset when allocation is moved (by defragmentation).
+         * Allocations never move by default
+         *
+         * @param info Buffer info
+         * @param callback Callback
+         */
+        virtual void setRelocationCallback([[maybe_unused]] BufferInfo const& info,
+                                           [[maybe_unused]] std::function<void(vk::Buffer, vk::DeviceSize)> callback) {}
+
+        /**
+         * @brief Get device memory allocated by allocator in a heap
+         *
+         * @param heap Heap index
+         * @return vk::DeviceSize Memory size (in bytes)
+         */
+        vk::DeviceSize heapUsage(u32 heap) const {
+            return this->heap_usages.at(heap);
+        }
+
+        /**
+         * @brief Get heap's budget. With VK_EXT_memory_budget usage is process-wide, otherwise it is allocator's usage
+         * and budget is 80% of heap's size
+         *
+         * @param heap Heap index
+         * @return HeapBudget Budget
+         */
+        HeapBudget budget(u32 heap) const;
+
+        /**
+         * @brief Get statistics, allocators sub-allocating blocks report their free space
+         *
+         * @return Statistics Statistics
+         */
+        virtual Statistics statistics() const;
+
+        /**
+         * @brief Dump statistics and heaps' budgets as JSON
+         *
+         * @return std::string JSON
+         */
+        std::string dump() const;
+
+        /**
+         * @brief Set file where dump is written when an allocation fails because memory is exhausted
+         *
+         * @param path Path, std::nullopt to disable it
+         */
+        void setOutOfMemoryDump(std::optional<std::string> path) {
+            this->out_of_memory_dump = path;
+        }
+
+        /**
+         * @brief Set callback called when a heap exceeds its budget after an allocation of device memory, so that resources can be evicted.
+         * It's called before allocate() returns, once allocator's locks are released, so it can free allocations
+         *
+         * @param callback Callback
+         */
+        void setOverBudgetCallback(std::function<void(u32, HeapBudget)> callback) {
+            this->over_budget = callback;
+        }
+
         Allocator& operator=(Allocator const&) = delete;
 
        protected:
+        std::array<std::atomic<vk::DeviceSize>, VK_MAX_MEMORY_HEAPS> heap_usages;
+        std::array<std::atomic<vk::DeviceSize>, VK_MAX_MEMORY_TYPES> type_usages;
+        std::array<std::atomic<size_t>, VK_MAX_MEMORY_TYPES> type_blocks;
+        std::array<std::atomic<size_t>, Statistics::HistogramSize> histogram;
+        std::atomic<vk::DeviceSize> allocated;
+        std::atomic<size_t> allocation_count;
+        std::atomic<u32> over_budget_heaps;
+        std::optional<std::string> out_of_memory_dump;
+        std::function<void(u32, HeapBudget)> over_budget;
         std::shared_ptr<Device> device;
+
+        /**
+         * @brief Track device memory allocated by allocator, heaps exceeding their budget are kept until notifyOverBudget()
+         *
+         * @param memory_type Memory type index
+         * @param size Memory size
+         */
+        void track(u32 memory_type, vk::DeviceSize size);
+
+        /**
+         * @brief Untrack device memory released by allocator
+         *
+         * @param memory_type Memory type index
+         * @param size Memory size
+         */
+        void untrack(u32 memory_type, vk::DeviceSize size);
+
+        /**
+         * @brief Count an allocation in statistics
+         *
+         * @param size Allocation's size
+         */
+        void trackAllocation(vk::DeviceSize size);
+
+        /**
+         * @brief Uncount an allocation from statistics
+         *
+         * @param size Allocation's size
+         */
+        void untrackAllocation(vk::DeviceSize size);
+
+        /**
+         * @brief Call over-budget callback for heaps exceeding their budget since last call.
+         * Allocator's locks mustn't be held, as callback may free allocations
+         *
+         */
+        void notifyOverBudget();
+
+        /**
+         * @brief Handle an allocation failure: dump is written if memory is exhausted and a dump file is set
+         *
+         * @param error Error
+         */
+        void allocationFailed(vk::SystemError const& error) const;
     };
 }  // namespace ao::vulkan
\ No newline at end of file
@@ -4,19 +4,46 @@
 
 #pragma once
 
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include <ao/core/memory/slot_table.hpp>
+
 #include "allocator.h"
+#include "memory_pool.h"
+#include "staging_ring.h"
 
 namespace ao::vulkan {
     /**
-     * @brief Allocator for device memory
+     * @brief Device memory allocation strategies
+     *
+     */
+    enum class DeviceAllocationStrategy { eDedicated, eTLSF };
+
+    /**
+     * @brief Transfer modes
+     *
+     */
+    enum class TransferMode { eImmediate, eDeferred };
+
+    /**
+     * @brief Allocator for device memory. On unified memory devices, allocations are device-local host-visible memory
+     * written directly through their pointer, without host buffers nor transfers
      *
      */
     class DeviceAllocator : public Allocator {
        public:
+        static constexpr vk::DeviceSize DefaultBlockSize = 64 * 1024 * 1024;
+
         struct Allocation {
+            vk::DeviceSize size = 0;  // Requested size, device range may be bigger
             std::pair<Allocator::BufferInfo, vk::DeviceMemory> host, device;
-            vk::CommandBuffer command;
-            Fence fence;
+            MemoryBlock* block = nullptr;
+            std::vector<char> shadow;
+            u32 host_memory_type = 0, device_memory_type = 0;
+            std::function<void(vk::Buffer, vk::DeviceSize)> relocation;
         };
 
         /**
@@ -25,8 +52,14 @@ namespace ao::vulkan {
          * @param device Device
          * @param cmd_usage Command usage
          * @param alignment Alignment
+         * @param strategy Strategy used to allocate device memory
+         * @param block_size Size of memory blocks (ignored by eDedicated strategy)
+         * @param staging_ring Staging ring used to transfer data to device, if null each allocation owns a host-visible buffer
+         * (unused on unified memory devices)
          */
-        DeviceAllocator(std::shared_ptr<Device> device, vk::CommandBufferUsageFlags cmd_usage, size_t alignment = 0);
+        DeviceAllocator(std::shared_ptr<Device> device, vk::CommandBufferUsageFlags cmd_usage, size_t alignment = 0,
+                        DeviceAllocationStrategy strategy = DeviceAllocationStrategy::eDedicated, vk::DeviceSize block_size = DefaultBlockSize,
+                        std::shared_ptr<StagingRing> staging_ring = nullptr);
 
         /**
          * @brief Destroy the Device Allocator object
@@ -34,6 +67,65 @@ namespace ao::vulkan {
          */
         ~DeviceAllocator();
 
+        /**
+         * @brief Set transfer mode, in eDeferred mode invalidated ranges are transferred by flush().
+         * Switching to eImmediate mode flushes pending ranges
+         *
+         * @param mode Mode
+         */
+        void setTransferMode(TransferMode mode);
+
+        /**
+         * @brief Get transfer mode
+         *
+         * @return TransferMode Mode
+         */
+        TransferMode transferMode() const {
+            return this->transfer_mode;
+        }
+
+        /**
+         * @brief Transfer pending ranges to device, overlapping or adjacent ranges are coalesced and recorded in a single command buffer.
+         * Without staging ring, host buffers are read by the transfer so they shouldn't be modified until {fence} is signaled
+         *
+         * @param signal Semaphore signaled once transfer is over (render submission can wait on it), can be null
+         * @return Fence Fence signaled once transfer is over, empty if nothing is submitted
+         */
+        Fence flush(vk::Semaphore signal = vk::Semaphore());
+
+        /**
+         * @brief Move up to {max_bytes} of allocations out of the least used memory block (eTLSF strategy only) using GPU copies,
+         * a block is released once it's empty. Owners are told about their new buffer/offset through relocation callbacks,
+         * moved data is valid once {fence} is signaled. Allocations with pending ranges aren't moved, nor unified memory as it's mapped
+         *
+         * @param max_bytes Maximal count of bytes to move (one allocation is moved at least)
+         * @param signal Semaphore signaled once copies are over, can be null
+         * @return Fence Fence signaled once copies are over, empty if nothing is moved
+         */
+        Fence defragment(vk::DeviceSize max_bytes, vk::Semaphore signal = vk::Semaphore());
+
+        /**
+         * @brief Get count of memory blocks
+         *
+         * @return size_t Count
+         */
+        size_t blockCount() const {
+            return this->pool ? this->pool->blockCount() : 0;
+        }
+
+        /**
+         * @brief Set size above which allocations get dedicated memory instead of being sub-allocated (eTLSF strategy only,
+         * block's size by default). With eDedicated strategy every allocation is dedicated
+         *
+         * @param threshold Threshold (in bytes)
+         */
+        void setDedicatedThreshold(vk::DeviceSize threshold) {
+            if (this->pool && this->strategy == DeviceAllocationStrategy::eTLSF) {
+                std::lock_guard lock(this->pool_mutex);
+                this->pool->setDedicatedThreshold(threshold);
+            }
+        }
+
         /**
          * @brief Free host buffer
          *
@@ -46,27 +138,137 @@ namespace ao::vulkan {
          *
          * @return vk::DeviceSize Memory size (in bytes)
          */
-        virtual vk::DeviceSize sizeOnDevice() const;
+        virtual vk::DeviceSize sizeOnDevice() const {
+            return this->device_size;
+        }
 
         /**
-         * @brief Get memory used on device
+         * @brief Get memory used on host by staging buffers, or by host copies with a staging ring (ring's memory isn't included)
          *
          * @return vk::DeviceSize Memory size (in bytes)
          */
-        virtual vk::DeviceSize sizeOnHost() const;
+        virtual vk::DeviceSize sizeOnHost() const {
+            return this->host_size;
+        }
+
+        /**
+         * @brief Get staging ring
+         *
+         * @return std::shared_ptr<StagingRing> Staging ring, null if allocations own their staging buffer or memory is unified
+         */
+        std::shared_ptr<StagingRing> stagingRing() const {
+            return this->staging_ring;
+        }
+
+        /**
+         * @brief Copy first {size} bytes of {source} into {destination}, host copies are copied on host and device buffers
+         * with a GPU copy (pending ranges of {source} are transferred before). Waits for the copy
+         *
+         * @param source Source
+         * @param destination Destination
+         * @param size Size
+         */
+        virtual void copy(BufferInfo const& source, BufferInfo const& destination, vk::DeviceSize size) override;
 
         virtual void invalidate(BufferInfo const& info, vk::DeviceSize const& offset, vk::DeviceSize const& size) override;
+        virtual void invalidateRanges(BufferInfo const& info, std::map<vk::DeviceSize, vk::DeviceSize> const& ranges) override;
         virtual Allocator::BufferInfo allocate(vk::DeviceSize size, vk::BufferUsageFlags usage) override;
         virtual void free(Allocator::BufferInfo const& info) override;
         virtual bool own(BufferInfo const& info) const override;
+        virtual void setRelocationCallback(BufferInfo const& info, std::function<void(vk::Buffer, vk::DeviceSize)> callback) override;
         virtual size_t alignSize(size_t size) const override;
-        virtual vk::DeviceSize size() const override;
+        virtual vk::DeviceSize size() const override {
+            return this->host_size + this->device_size;
+        }
+        virtual Statistics statistics() const override;
 
        protected:
-        std::map<vk::Buffer, Allocation> allocations;
-        std::mutex allocations_mutex;
+        /**
+         * @brief Command buffer & fence of a transfer, with handles of allocations it uses
+         *
+         */
+        struct Batch {
+            vk::CommandBuffer command;
+            Fence fence;
+            std::vector<u64> handles;
+        };
+
+        core::SlotTable<Allocation> allocations;
+        std::atomic<vk::DeviceSize> host_size, device_size;
+        std::vector<std::pair<Fence, MemoryPool::Range>> retired_ranges;
+        std::unique_ptr<MemoryPool> pool;
+        mutable std::mutex pool_mutex;
+
+        std::map<u64, std::map<vk::DeviceSize, vk::DeviceSize>> pending;
+        std::shared_ptr<StagingRing> staging_ring;
+        std::vector<Batch> batches;
+        TransferMode transfer_mode;
+        std::mutex transfer_mutex;
 
         vk::CommandBufferUsageFlags cmd_usage;
         size_t alignment;
+        DeviceAllocationStrategy strategy;
+        bool unified_memory;
+
+        /**
+         * @brief Get pointer to host copy of {allocation} (mapped device memory on unified memory devices)
+         *
+         * @param allocation Allocation
+         * @return std::optional<void*> Pointer, null if host copy is freed
+         */
+        std::optional<void*> hostPtr(Allocation const& allocation) const;
+
+        /**
+         * @brief Release ranges moved by defragmentation whose copy is over ({pool_mutex} must be locked)
+         *
+         */
+        void releaseRetiredRanges();
+
+        /**
+         * @brief Check that a range ending at {end} is inside {allocation}, so that its copy doesn't write into neighbouring ranges
+         *
+         * @param allocation Allocation
+         * @param end Range's end
+         */
+        void checkRange(Allocation const& allocation, vk::DeviceSize end) const;
+
+        /**
+         * @brief Get fences of batches using allocation {handle} ({transfer_mutex} must be locked)
+         *
+         * @param handle Handle
+         * @return std::vector<Fence> Fences
+         */
+        std::vector<Fence> batchFences(u64 handle) const;
+
+        /**
+         * @brief Destroy host buffer & dedicated device memory of {allocation}, or release its range.
+         * Resources that aren't created yet are skipped
+         *
+         * @param allocation Allocation
+         */
+        void release(Allocation& allocation);
+
+        /**
+         * @brief Get a batch whose transfer is over, or create one
+         *
+         * @return Batch& Batch
+         */
+        Batch& acquireBatch();
+
+        /**
+         * @brief Submit a batch, in-flight batches using the same allocations are waited first
+         *
+         * @param batch Batch
+         * @param signal Semaphore to signal, can be null
+         */
+        void submitBatch(Batch& batch, vk::Semaphore signal);
+
+        /**
+         * @brief Transfer pending ranges to device ({transfer_mutex} must be locked)
+         *
+         * @param signal Semaphore to signal, can be null
+         * @return Fence Fence, empty if nothing is submitted
+         */
+        Fence submitPending(vk::Semaphore signal);
     };
 }  // namespace ao::vulkan
\ No newline at end of file
@@ -0,0 +1,41 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#pragma once
+
+#include <map>
+
+#include "sub_allocator.h"
+
+namespace ao::vulkan {
+    /**
+     * @brief First-fit sub-allocator that coalesces adjacent free ranges
+     *
+     */
+    class FreeList : public SubAllocator {
+       public:
+        /**
+         * @brief Construct a new FreeList object
+         *
+         * @param size Size of managed range
+         */
+        explicit FreeList(vk::DeviceSize size);
+
+        /**
+         * @brief Destroy the FreeList object
+         *
+         */
+        virtual ~FreeList() = default;
+
+        virtual std::optional<vk::DeviceSize> allocate(vk::DeviceSize size, vk::DeviceSize alignment) override;
+        virtual void free(vk::DeviceSize offset) override;
+        virtual vk::DeviceSize used() const override;
+        virtual vk::DeviceSize largestFree() const override;
+
+       protected:
+        std::map<vk::DeviceSize, vk::DeviceSize> free_ranges;
+        std::map<vk::DeviceSize, vk::DeviceSize> ranges;
+        vk::DeviceSize used_;
+    };
+}  // namespace ao::vulkan
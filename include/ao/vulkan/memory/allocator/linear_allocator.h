@@ -0,0 +1,96 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "allocator.h"
+#include "memory_block.h"
+
+namespace ao::vulkan {
+    /**
+     * @brief Allocator for transient data, owns a mapped buffer per frame in flight and allocates by pointer bump.
+     * Memory isn't freed per allocation, a frame's buffer is released at once by reset()
+     *
+     */
+    class LinearAllocator : public Allocator {
+       public:
+        static constexpr vk::DeviceSize DefaultSize = 4 * 1024 * 1024;
+
+        /**
+         * @brief Construct a new LinearAllocator object
+         *
+         * @param device Device
+         * @param frames Count of frames in flight
+         * @param size Size of a frame's buffer
+         * @param usage Usage of buffers
+         * @param alignment Alignment
+         */
+        LinearAllocator(std::shared_ptr<Device> device, size_t frames, vk::DeviceSize size = DefaultSize,
+                        vk::BufferUsageFlags usage = vk::BufferUsageFlagBits::eUniformBuffer | vk::BufferUsageFlagBits::eVertexBuffer |
+                                                     vk::BufferUsageFlagBits::eIndexBuffer,
+                        size_t alignment = 0);
+
+        /**
+         * @brief Destroy the LinearAllocator object
+         *
+         */
+        virtual ~LinearAllocator();
+
+        /**
+         * @brief Release every allocation of {frame} and make it the current frame.
+         * GPU mustn't use frame's buffer anymore (its fence must be signaled)
+         *
+         * @param frame Frame index
+         */
+        void reset(size_t frame);
+
+        /**
+         * @brief Get current frame
+         *
+         * @return size_t Frame index
+         */
+        size_t frame() const {
+            return this->current;
+        }
+
+        /**
+         * @brief Get count of frames
+         *
+         * @return size_t Count
+         */
+        size_t frames() const {
+            return this->blocks.size();
+        }
+
+        /**
+         * @brief Get capacity of a frame's buffer
+         *
+         * @return vk::DeviceSize Size (in bytes)
+         */
+        vk::DeviceSize capacity() const {
+            return this->blocks.front()->size();
+        }
+
+        virtual void invalidate(BufferInfo const& info, vk::DeviceSize const& offset, vk::DeviceSize const& size) override;
+        virtual Allocator::BufferInfo allocate(vk::DeviceSize size, vk::BufferUsageFlags usage) override;
+        virtual void free(Allocator::BufferInfo const& info) override;
+        virtual bool own(BufferInfo const& info) const override;
+        virtual size_t alignSize(size_t size) const override;
+        virtual vk::DeviceSize size() const override;
+
+       protected:
+        std::vector<std::unique_ptr<MemoryBlock>> blocks;
+        std::atomic<vk::DeviceSize> head;
+        size_t current;
+
+        std::vector<std::vector<vk::DeviceSize>> allocations;  // Allocation sizes of each frame, untracked by reset()
+        std::mutex allocations_mutex;
+
+        size_t alignment;
+    };
+}  // namespace ao::vulkan
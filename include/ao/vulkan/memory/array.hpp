@@ -5,6 +5,7 @@
 #pragma once
 
 #include <ao/core/memory/ptr_iterator.hpp>
+#include <ao/core/utilities/memory.h>
 
 #include "allocator/allocator.h"
 #include "buffer.h"
@@ -37,6 +38,29 @@ namespace ao::vulkan {
          */
         Array(T const& value, std::shared_ptr<Allocator> allocator, vk::BufferUsageFlags usage = vk::BufferUsageFlags());
 
+        /**
+         * @brief Construct a new Array object, {count} first elements are copied from {data} with a bulk copy (see upload())
+         *
+         * @param data Data
+         * @param count Count
+         * @param allocator Allocator
+         * @param usage Buffer usage
+         */
+        Array(T const* data, size_t count, std::shared_ptr<Allocator> allocator, vk::BufferUsageFlags usage = vk::BufferUsageFlags())
+            : Array(allocator, usage) {
+            this->upload(data, count);
+        }
+
+        /**
+         * @brief Construct a new Array object, first elements are copied from {data} with a bulk copy (see upload())
+         *
+         * @param data Data
+         * @param allocator Allocator
+         * @param usage Buffer usage
+         */
+        Array(core::Span<T const> data, std::shared_ptr<Allocator> allocator, vk::BufferUsageFlags usage = vk::BufferUsageFlags())
+            : Array(data.data(), data.size(), allocator, usage) {}
+
         /**
          * @brief Destroy the Array object
          *
@@ -78,7 +102,26 @@ namespace ao::vulkan {
          * @return core::PtrIterator<T> Iterator
          */
         virtual core::PtrIterator<T> end() {
-            return core::PtrIterator<T>(static_cast<T*>(*this->buffer_info->ptr) + N);
+            return this->begin() + N;
+        }
+
+        /**
+         * @brief Get pointer to first element
+         *
+         * @return T* Pointer
+         */
+        T* data() {
+            return static_cast<T*>(*this->buffer_info->ptr);
+        }
+
+        /**
+         * @brief Check if elements are contiguous (stride is sizeof(T)), then data() can be used as a plain array
+         *
+         * @return true Elements are contiguous
+         * @return false Elements are strided
+         */
+        bool contiguous() const {
+            return this->stride == sizeof(T);
         }
 
         /**
@@ -91,12 +134,22 @@ namespace ao::vulkan {
         }
 
         /**
-         * @brief Get offset of object at index {index}
+         * @brief Get offset of object at index {index} in info().buffer, to bind it
+         *
+         * @param index Index
+         * @return vk::DeviceSize Offset
+         */
+        vk::DeviceSize offset(size_t index) const {
+            return this->buffer_info->offset + this->relativeOffset(index);
+        }
+
+        /**
+         * @brief Get offset of object at index {index} from start of allocation (info().ptr)
          *
          * @param index Index
          * @return vk::DeviceSize Offset
          */
-        virtual vk::DeviceSize offset(size_t index) const {
+        virtual vk::DeviceSize relativeOffset(size_t index) const {
             return this->stride * index;
         }
 
@@ -107,7 +160,46 @@ namespace ao::vulkan {
          * @param count Count
          */
         virtual void invalidate(size_t index, size_t count = 1) {
-            this->allocator_->invalidate(*this->buffer_info, this->offset(index), count * this->stride);
+            this->allocator_->invalidate(*this->buffer_info, this->relativeOffset(index), count * this->stride);
+        }
+
+        /**
+         * @brief Mark {count} objects from {index} as dirty, they're invalidated by flush()
+         *
+         * @param index Index
+         * @param count Count
+         */
+        void markDirty(size_t index, size_t count = 1) {
+            Buffer::markDirty(this->relativeOffset(index), count * this->stride);
+        }
+
+        /**
+         * @brief Copy {value} into each element, then invalidate them at once
+         *
+         * @param value Value
+         */
+        void fill(T const& value) {
+            core::utilities::stridedFill(*this->buffer_info->ptr, this->stride, value, N);
+            this->invalidate(0, N);
+        }
+
+        /**
+         * @brief Copy {count} elements of {data} from {index} with a bulk copy, then invalidate them at once
+         *
+         * @param data Data
+         * @param count Count
+         * @param index Index of first element to write
+         */
+        void upload(T const* data, size_t count, size_t index = 0) {
+            if (index + count > N) {
+                throw core::Exception(fmt::format("Range [{}, {}) is out of range [0, {})", index, index + count, N));
+            }
+            if (count == 0) {
+                return;
+            }
+
+            core::utilities::stridedCopy(&this->at(index), this->stride, data, count);
+            this->invalidate(index, count);
         }
 
        protected:
@@ -117,9 +209,7 @@ namespace ao::vulkan {
     template<size_t N, class T>
     Array<N, T>::Array(T const& value, std::shared_ptr<Allocator> allocator, vk::BufferUsageFlags usage) : Array<N, T>(allocator, usage) {
         // Fill
-        for (size_t i = 0; i < N; i++) {
-            this->at(i) = value;
-        }
+        core::utilities::stridedFill(*this->buffer_info->ptr, this->stride, value, N);
 
         // Notify
         this->allocator_->invalidate(*this->buffer_info, 0, this->buffer_info->size);
@@ -47,12 +47,22 @@ namespace ao::vulkan {
         virtual ~Tuple() = default;
 
         /**
-         * @brief Get offset of object at index {index}
+         * @brief Get offset of object at index {index} in info().buffer, to bind it
          *
          * @param index Index
          * @return vk::DeviceSize Offset
          */
-        virtual vk::DeviceSize offset(size_t index) const {
+        vk::DeviceSize offset(size_t index) const {
+            return this->buffer_info->offset + this->relativeOffset(index);
+        }
+
+        /**
+         * @brief Get offset of object at index {index} from start of allocation (info().ptr)
+         *
+         * @param index Index
+         * @return vk::DeviceSize Offset
+         */
+        virtual vk::DeviceSize relativeOffset(size_t index) const {
             return this->offsets[index];
         }
 
@@ -63,13 +73,32 @@ namespace ao::vulkan {
          * @param count Count
          */
         virtual void invalidate(size_t index, size_t count = 1) {
-            this->allocator_->invalidate(*this->buffer_info, this->offset(index),
-                                         std::accumulate(this->offsets.begin() + index, this->offsets.begin() + index + count, vk::DeviceSize(0),
-                                                         std::plus<vk::DeviceSize>()));
+            this->allocator_->invalidate(*this->buffer_info, this->relativeOffset(index), this->rangeSize(index, count));
+        }
+
+        /**
+         * @brief Mark {count} objects from {index} as dirty, they're invalidated by flush()
+         *
+         * @param index Index
+         * @param count Count
+         */
+        void markDirty(size_t index, size_t count = 1) {
+            Buffer::markDirty(this->relativeOffset(index), this->rangeSize(index, count));
         }
 
        protected:
         std::array<vk::DeviceSize, sizeof...(T)> offsets;
+
+        /**
+         * @brief Get size of {count} objects from {index}
+         *
+         * @param index Index
+         * @param count Count
+         * @return vk::DeviceSize Size
+         */
+        vk::DeviceSize rangeSize(size_t index, size_t count) const {
+            return (index + count < sizeof...(T) ? this->offsets[index + count] : this->buffer_info->size) - this->offsets[index];
+        }
     };
 
     template<class... T>
@@ -96,7 +125,7 @@ namespace ao::vulkan {
         template<size_t Index, class... T>
         inline typename std::tuple_element<Index, std::tuple<T...>>::type& get(Tuple<T...>& tuple) {
             return *reinterpret_cast<typename std::tuple_element<Index, std::tuple<T...>>::type*>(static_cast<char*>(*tuple.info().ptr) +
-                                                                                                  tuple.offset(Index));
+                                                                                                  tuple.relativeOffset(Index));
         }
     }  // namespace
 }  // namespace ao::vulkan
\ No newline at end of file
@@ -4,7 +4,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <new>
+#include <utility>
+
 #include <ao/core/memory/ptr_iterator.hpp>
+#include <ao/core/utilities/memory.h>
 
 #include "allocator/allocator.h"
 #include "buffer.h"
@@ -12,7 +17,8 @@
 namespace ao::vulkan {
 
     /**
-     * @brief Vulkan buffer with std::vector interface
+     * @brief Vulkan buffer with std::vector interface, capacity grows geometrically and old content is copied by allocator
+     * (on device for DeviceAllocator). Reallocation changes buffer, see setAfterRelocation()
      *
      * @tparam T Type of elements
      */
@@ -20,24 +26,50 @@ namespace ao::vulkan {
     class Vector : public Buffer {
        public:
         /**
-         * @brief Construct a new Vector object
+         * @brief Construct a new Vector object, elements aren't initialized
          *
-         * @param capacity Capacity
+         * @param size Size
          * @param allocator Allocator
          * @param usage Buffer usage
          */
-        Vector(size_t capacity, std::shared_ptr<Allocator> allocator, vk::BufferUsageFlags usage = vk::BufferUsageFlags())
-            : Buffer(allocator, capacity * allocator->alignSize(sizeof(T)), usage), capacity(capacity), stride(allocator->alignSize(sizeof(T))) {}
+        Vector(size_t size, std::shared_ptr<Allocator> allocator, vk::BufferUsageFlags usage = vk::BufferUsageFlags())
+            : Buffer(allocator, (std::max)(size, size_t(1)) * allocator->alignSize(sizeof(T)), usage),
+              size_(size),
+              capacity_((std::max)(size, size_t(1))),
+              stride(allocator->alignSize(sizeof(T))) {}
 
         /**
          * @brief Construct a new Vector object
          *
-         * @param capacity Capacity
+         * @param size Size
          * @param value Value to copy in each element
          * @param allocator Allocator
          * @param usage Buffer usage
          */
-        Vector(size_t capacity, T const& value, std::shared_ptr<Allocator> allocator, vk::BufferUsageFlags usage = vk::BufferUsageFlags());
+        Vector(size_t size, T const& value, std::shared_ptr<Allocator> allocator, vk::BufferUsageFlags usage = vk::BufferUsageFlags());
+
+        /**
+         * @brief Construct a new Vector object holding {count} elements copied from {data} with a bulk copy (see upload())
+         *
+         * @param data Data
+         * @param count Count
+         * @param allocator Allocator
+         * @param usage Buffer usage
+         */
+        Vector(T const* data, size_t count, std::shared_ptr<Allocator> allocator, vk::BufferUsageFlags usage = vk::BufferUsageFlags())
+            : Vector(count, allocator, usage) {
+            this->upload(data, count);
+        }
+
+        /**
+         * @brief Construct a new Vector object holding a copy of {data} made with a bulk copy (see upload())
+         *
+         * @param data Data
+         * @param allocator Allocator
+         * @param usage Buffer usage
+         */
+        Vector(core::Span<T const> data, std::shared_ptr<Allocator> allocator, vk::BufferUsageFlags usage = vk::BufferUsageFlags())
+            : Vector(data.data(), data.size(), allocator, usage) {}
 
         /**
          * @brief Destroy the vector object
@@ -80,7 +112,26 @@ namespace ao::vulkan {
          * @return core::PtrIterator<T> Iterator
          */
         virtual core::PtrIterator<T> end() {
-            return core::PtrIterator<T>(static_cast<T*>(*this->buffer_info->ptr) + this->capacity);
+            return this->begin() + this->size_;
+        }
+
+        /**
+         * @brief Get pointer to first element
+         *
+         * @return T* Pointer
+         */
+        T* data() {
+            return static_cast<T*>(*this->buffer_info->ptr);
+        }
+
+        /**
+         * @brief Check if elements are contiguous (stride is sizeof(T)), then data() can be used as a plain array
+         *
+         * @return true Elements are contiguous
+         * @return false Elements are strided
+         */
+        bool contiguous() const {
+            return this->stride == sizeof(T);
         }
 
         /**
@@ -89,16 +140,136 @@ namespace ao::vulkan {
          * @return size_t Size
          */
         virtual size_t size() const {
-            return this->capacity;
+            return this->size_;
+        }
+
+        /**
+         * @brief Get capacity
+         *
+         * @return size_t Capacity
+         */
+        size_t capacity() const {
+            return this->capacity_;
+        }
+
+        /**
+         * @brief Check if vector is empty
+         *
+         * @return true Vector is empty
+         * @return false Vector isn't empty
+         */
+        bool empty() const {
+            return this->size_ == 0;
+        }
+
+        /**
+         * @brief Reallocate buffer if {capacity} is greater than current capacity
+         *
+         * @param capacity Capacity
+         */
+        void reserve(size_t capacity) {
+            if (capacity > this->capacity_) {
+                this->reallocate(capacity * this->stride, this->size_ * this->stride);
+                this->capacity_ = capacity;
+            }
         }
 
         /**
-         * @brief Get offset of object at index {index}
+         * @brief Resize vector, new elements aren't initialized
+         *
+         * @param size Size
+         */
+        void resize(size_t size) {
+            if (size > this->capacity_) {
+                this->reserve((std::max)(size, this->capacity_ * 2));
+            }
+            this->size_ = size;
+        }
+
+        /**
+         * @brief Resize vector, {value} is copied into new elements
+         *
+         * @param size Size
+         * @param value Value
+         */
+        void resize(size_t size, T const& value) {
+            size_t old_size = this->size_;
+
+            this->resize(size);
+            for (size_t i = old_size; i < size; i++) {
+                this->at(i) = value;
+            }
+        }
+
+        /**
+         * @brief Append an element (amortized O(1)), it must be invalidated to be transferred
+         *
+         * @param value Value
+         */
+        void push_back(T const& value) {
+            this->resize(this->size_ + 1);
+            this->at(this->size_ - 1) = value;
+        }
+
+        /**
+         * @brief Append an element constructed in place (amortized O(1)), it must be invalidated to be transferred
+         *
+         * @tparam Args Argument types
+         * @param args Arguments
+         * @return T& Element
+         */
+        template<class... Args>
+        T& emplace_back(Args&&... args) {
+            this->resize(this->size_ + 1);
+            return *new (&this->at(this->size_ - 1)) T(std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Remove last element
+         *
+         */
+        void pop_back() {
+            this->size_--;
+        }
+
+        /**
+         * @brief Remove every element, capacity isn't changed
+         *
+         */
+        void clear() {
+            this->size_ = 0;
+        }
+
+        /**
+         * @brief Reallocate buffer to fit size
+         *
+         */
+        void shrink_to_fit() {
+            size_t capacity = (std::max)(this->size_, size_t(1));
+
+            if (capacity < this->capacity_) {
+                this->reallocate(capacity * this->stride, this->size_ * this->stride);
+                this->capacity_ = capacity;
+            }
+        }
+
+        /**
+         * @brief Get offset of object at index {index} in info().buffer, to bind it
          *
          * @param index Index
          * @return vk::DeviceSize Offset
          */
-        virtual vk::DeviceSize offset(size_t index) const {
+        vk::DeviceSize offset(size_t index) const {
+            return this->buffer_info->offset + this->relativeOffset(index);
+        }
+
+        /**
+         * @brief Get offset of object at index {index} from start of allocation (info().ptr)
+         *
+         * @param index Index
+         * @return vk::DeviceSize Offset
+         */
+        virtual vk::DeviceSize relativeOffset(size_t index) const {
             return this->stride * index;
         }
 
@@ -109,21 +280,78 @@ namespace ao::vulkan {
          * @param count Count
          */
         virtual void invalidate(size_t index, size_t count = 1) {
-            this->allocator_->invalidate(*this->buffer_info, this->offset(index), count * this->stride);
+            this->allocator_->invalidate(*this->buffer_info, this->relativeOffset(index), count * this->stride);
+        }
+
+        /**
+         * @brief Mark {count} objects from {index} as dirty, they're invalidated by flush()
+         *
+         * @param index Index
+         * @param count Count
+         */
+        void markDirty(size_t index, size_t count = 1) {
+            Buffer::markDirty(this->relativeOffset(index), count * this->stride);
+        }
+
+        /**
+         * @brief Copy {value} into each element, then invalidate them at once
+         *
+         * @param value Value
+         */
+        void fill(T const& value) {
+            if (this->size_ == 0) {
+                return;
+            }
+
+            core::utilities::stridedFill(*this->buffer_info->ptr, this->stride, value, this->size_);
+            this->invalidate(0, this->size_);
+        }
+
+        /**
+         * @brief Copy {count} elements of {data} from {index} with a bulk copy, then invalidate them at once
+         *
+         * @param data Data
+         * @param count Count
+         * @param index Index of first element to write
+         */
+        void upload(T const* data, size_t count, size_t index = 0) {
+            if (index + count > this->size_) {
+                throw core::Exception(fmt::format("Range [{}, {}) is out of range [0, {})", index, index + count, this->size_));
+            }
+            if (count == 0) {
+                return;
+            }
+
+            core::utilities::stridedCopy(&this->at(index), this->stride, data, count);
+            this->invalidate(index, count);
+        }
+
+        /**
+         * @brief Replace content with {count} elements of {data}, buffer is reallocated without copy if it's too small
+         *
+         * @param data Data
+         * @param count Count
+         */
+        void assign(T const* data, size_t count) {
+            if (count > this->capacity_) {
+                this->reallocate(count * this->stride, 0);
+                this->capacity_ = count;
+            }
+            this->size_ = count;
+            this->upload(data, count);
         }
 
        protected:
-        size_t capacity;
+        size_t size_;
+        size_t capacity_;
         size_t stride;
     };
 
     template<class T>
-    Vector<T>::Vector(size_t capacity, T const& value, std::shared_ptr<Allocator> allocator, vk::BufferUsageFlags usage)
-        : Vector<T>::Vector(capacity, allocator, usage) {
+    Vector<T>::Vector(size_t size, T const& value, std::shared_ptr<Allocator> allocator, vk::BufferUsageFlags usage)
+        : Vector<T>::Vector(size, allocator, usage) {
         // Fill
-        for (size_t i = 0; i < capacity; i++) {
-            this->at(i) = value;
-        }
+        core::utilities::stridedFill(*this->buffer_info->ptr, this->stride, value, size);
 
         // Notify
         this->allocator_->invalidate(*this->buffer_info, 0, this->buffer_info->size);
@@ -51,14 +51,12 @@ namespace ao::vulkan::utilities {
     /**
      * @brief Find memory type
      *
-     * @param device
+     * @param mem_properties Memory properties
      * @param memory_type_bits Type bits
      * @param properties Properties
      * @return u32 Index
      */
-    inline u32 memoryType(vk::PhysicalDevice device, u32 memory_type_bits, vk::MemoryPropertyFlags properties) {
-        auto mem_properties = device.getMemoryProperties();
-
+    inline u32 memoryType(vk::PhysicalDeviceMemoryProperties const& mem_properties, u32 memory_type_bits, vk::MemoryPropertyFlags properties) {
         for (u32 i = 0; i < mem_properties.memoryTypeCount; i++) {
             if ((memory_type_bits & 1) == 1) {
                 if ((mem_properties.memoryTypes[i].propertyFlags & properties) == properties) {
@@ -70,11 +68,23 @@ namespace ao::vulkan::utilities {
         throw ao::core::Exception("Fail to find a matching memory type");
     }
 
+    /**
+     * @brief Find memory type (memory properties are queried, prefer Device::memoryType() that uses cached ones)
+     *
+     * @param device
+     * @param memory_type_bits Type bits
+     * @param properties Properties
+     * @return u32 Index
+     */
+    inline u32 memoryType(vk::PhysicalDevice device, u32 memory_type_bits, vk::MemoryPropertyFlags properties) {
+        return memoryType(device.getMemoryProperties(), memory_type_bits, properties);
+    }
+
     /**
      * @brief Create a vk::Image
      *
      * @param device Logical device
-     * @param physical_device Physical device
+     * @param mem_properties Memory properties
      * @param width Width
      * @param height height
      * @param mip_levels Mip levels
@@ -86,8 +96,8 @@ namespace ao::vulkan::utilities {
      * @param memory_flags Memory flags
      * @return std::pair<vk::Image, vk::DeviceMemory> Image
      */
-    inline std::pair<vk::Image, vk::DeviceMemory> createImage(vk::Device device, vk::PhysicalDevice physical_device, u32 width, u32 height,
-                                                              u32 mip_levels, u32 array_layers, vk::Format format, vk::ImageType type,
+    inline std::pair<vk::Image, vk::DeviceMemory> createImage(vk::Device device, vk::PhysicalDeviceMemoryProperties const& mem_properties, u32 width,
+                                                              u32 height, u32 mip_levels, u32 array_layers, vk::Format format, vk::ImageType type,
                                                               vk::ImageTiling tiling, vk::ImageUsageFlags usage_flags,
                                                               vk::MemoryPropertyFlags memory_flags) {
         std::pair<vk::Image, vk::DeviceMemory> pair;
@@ -100,9 +110,11 @@ namespace ao::vulkan::utilities {
         // Get memory requirements
         vk::MemoryRequirements mem_requirements = device.getImageMemoryRequirements(pair.first);
 
-        // Allocate	memory
+        // Allocate memory (image owns it, so it's a dedicated allocation)
+        auto dedicated_info = vk::MemoryDedicatedAllocateInfo(pair.first);
         pair.second = device.allocateMemory(
-            vk::MemoryAllocateInfo(mem_requirements.size, memoryType(physical_device, mem_requirements.memoryTypeBits, memory_flags)));
+            vk::MemoryAllocateInfo(mem_requirements.size, memoryType(mem_properties, mem_requirements.memoryTypeBits, memory_flags))
+                .setPNext(&dedicated_info));
 
         // Bind image and memory
         device.bindImageMemory(pair.first, pair.second, 0);
@@ -229,4 +241,38 @@ namespace ao::vulkan::utilities {
         transfer_command_pool.freeCommandBuffers(cmd);
         fence.destroy();
     }
+
+    /**
+     * @brief Copy vk::Image into a vk::Buffer
+     *
+     * @param device Device
+     * @param graphics_command_pool Graphics command pool
+     * @param queue_container Queue container
+     * @param image Image
+     * @param layout Image's layout (eTransferSrcOptimal or eGeneral)
+     * @param buffer Buffer
+     * @param regions Regions
+     */
+    inline void copyImageToBuffer(vk::Device device, CommandPool& graphics_command_pool, QueueContainer& queue_container, vk::Image image,
+                                  vk::ImageLayout layout, vk::Buffer buffer, vk::ArrayProxy<vk::BufferImageCopy const> regions) {
+        // Create command buffer
+        vk::CommandBuffer cmd = graphics_command_pool.allocateCommandBuffers(vk::CommandBufferLevel::ePrimary, 1).front();
+
+        cmd.begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+        cmd.copyImageToBuffer(image, layout, buffer, regions);
+        cmd.end();
+
+        // Create fence
+        Fence fence(std::make_shared<vk::Device>(device));
+
+        // Submit command
+        queue_container.submit(vk::QueueFlagBits::eGraphics, vk::SubmitInfo().setCommandBufferCount(1).setPCommandBuffers(&cmd), fence);
+
+        // Wait fence
+        fence.wait();
+
+        // Free command/fence
+        graphics_command_pool.freeCommandBuffers(cmd);
+        fence.destroy();
+    }
 }  // namespace ao::vulkan::utilities
@@ -0,0 +1,88 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#pragma once
+
+#include <vector>
+
+#include <vulkan/vulkan.hpp>
+
+#include "swapchain.h"
+
+namespace ao::vulkan {
+    /**
+     * @brief Swap chain without surface: images are a ring of offscreen color attachments that are never presented.
+     * Render passes must leave them in FinalLayout to read them back
+     *
+     */
+    class OffscreenSwapchain : public Swapchain {
+       public:
+        static constexpr vk::Format ColorFormat = vk::Format::eR8G8B8A8Unorm;
+        static constexpr vk::ImageLayout FinalLayout = vk::ImageLayout::eTransferSrcOptimal;
+
+        /**
+         * @brief Construct a new OffscreenSwapchain object
+         *
+         * @param instance Instance
+         * @param device Device
+         * @param images Count of images
+         */
+        OffscreenSwapchain(std::shared_ptr<vk::Instance> instance, std::shared_ptr<Device> device, u32 images = 3);
+
+        /**
+         * @brief Destroy the OffscreenSwapchain object
+         *
+         */
+        virtual ~OffscreenSwapchain();
+
+        /**
+         * @brief Initialize images, surface's size is kept as is
+         *
+         * @param surface_width Surface's width
+         * @param surface_height Surface's height
+         * @param vsync Ignored
+         * @param stencil_buffer Enable stencil buffer
+         */
+        virtual void init(u32& surface_width, u32& surface_height, bool vsync, bool stencil_buffer) override;
+
+        /**
+         * @brief Select color format and queue releasing images (graphics queue), there is no surface
+         *
+         */
+        virtual void initSurface() override;
+
+        /**
+         * @brief Acquire next image of the ring, {acquire} is signaled by an empty submission if it's set
+         *
+         * @param acquire Acquire semaphore
+         * @return vk::Result Result
+         */
+        virtual vk::Result acquireNextImage(vk::Semaphore acquire) override;
+
+        /**
+         * @brief Release current image, nothing is presented. {waiting_semaphores} are waited by an empty submission
+         *
+         * @param waiting_semaphores Waiting semaphores
+         * @return vk::Result Result
+         */
+        virtual vk::Result enqueueImage(vk::ArrayProxy<vk::Semaphore> waiting_semaphores) override;
+
+        /**
+         * @brief Read image at {index} back to host (tightly packed RGBA8 pixels). Image must be in FinalLayout and no longer in use
+         *
+         * @param index Image's index
+         * @return std::vector<u8> Pixels
+         */
+        std::vector<u8> read(u32 index) const;
+
+       protected:
+        std::vector<vk::DeviceMemory> memories;
+
+        /**
+         * @brief Destroy images, their views and their memory
+         *
+         */
+        void destroyImages();
+    };
+}  // namespace ao::vulkan
@@ -0,0 +1,88 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include <ao/vulkan/memory/allocator/device_allocator.h>
+#include <ao/vulkan/memory/allocator/host_allocator.h>
+
+#include "helpers/benchmarks.h"
+
+namespace ao::bench {
+    /**
+     * @brief Create an allocator
+     *
+     * @tparam A Allocator type
+     * @param instance Instance
+     * @return std::shared_ptr<A> Allocator
+     */
+    template<class A>
+    std::shared_ptr<A> makeAllocator(test::VkInstance* instance) {
+        if constexpr (std::is_same_v<A, vulkan::DeviceAllocator>) {
+            return std::make_shared<A>(instance->device, vk::CommandBufferUsageFlagBits::eOneTimeSubmit, 0,
+                                       vulkan::DeviceAllocationStrategy::eTLSF);
+        } else {
+            return std::make_shared<A>(instance->device);
+        }
+    }
+
+    template<class A>
+    void AllocateFree(::benchmark::State& state) {
+        auto context = instance();
+        SKIP_BENCHMARK(state, !context, VULKAN_INIT_FAILURE);
+
+        auto allocator = makeAllocator<A>(context);
+        auto size = static_cast<vk::DeviceSize>(state.range(0));
+
+        // Keep a block alive, so that loop measures sub-allocation
+        auto keep = allocator->allocate(size, vk::BufferUsageFlagBits::eStorageBuffer);
+        for (auto _ : state) {
+            allocator->free(allocator->allocate(size, vk::BufferUsageFlagBits::eStorageBuffer));
+        }
+        allocator->free(keep);
+
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK_TEMPLATE(AllocateFree, vulkan::HostAllocator)->RangeMultiplier(16)->Range(64, 1 << 20);
+    BENCHMARK_TEMPLATE(AllocateFree, vulkan::DeviceAllocator)->RangeMultiplier(16)->Range(64, 1 << 20);
+
+    template<class A>
+    void AllocateBatch(::benchmark::State& state) {
+        auto context = instance();
+        SKIP_BENCHMARK(state, !context, VULKAN_INIT_FAILURE);
+
+        auto allocator = makeAllocator<A>(context);
+        std::vector<vulkan::Allocator::BufferInfo> infos(static_cast<size_t>(state.range(0)));
+
+        for (auto _ : state) {
+            for (auto& info : infos) {
+                info = allocator->allocate(256, vk::BufferUsageFlagBits::eUniformBuffer);
+            }
+            for (auto& info : infos) {
+                allocator->free(info);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK_TEMPLATE(AllocateBatch, vulkan::HostAllocator)->Arg(1024);
+    BENCHMARK_TEMPLATE(AllocateBatch, vulkan::DeviceAllocator)->Arg(1024);
+
+    template<class A>
+    void Invalidate(::benchmark::State& state) {
+        auto context = instance();
+        SKIP_BENCHMARK(state, !context, VULKAN_INIT_FAILURE);
+
+        auto allocator = makeAllocator<A>(context);
+        auto size = static_cast<vk::DeviceSize>(state.range(0));
+        auto info = allocator->allocate(size, vk::BufferUsageFlagBits::eStorageBuffer);
+
+        for (auto _ : state) {
+            allocator->invalidate(info, 0, size);
+        }
+        allocator->free(info);
+
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK_TEMPLATE(Invalidate, vulkan::HostAllocator)->RangeMultiplier(16)->Range(64, 1 << 20);
+    BENCHMARK_TEMPLATE(Invalidate, vulkan::DeviceAllocator)->RangeMultiplier(16)->Range(64, 1 << 20);
+}  // namespace ao::bench
@@ -0,0 +1,144 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include <numeric>
+#include <vector>
+
+#include <ao/core/utilities/types.h>
+#include <ao/vulkan/memory/allocator/device_allocator.h>
+#include <ao/vulkan/memory/allocator/host_allocator.h>
+#include <ao/vulkan/memory/array.hpp>
+#include <ao/vulkan/memory/tuple.hpp>
+#include <ao/vulkan/memory/vector.hpp>
+
+#include "helpers/benchmarks.h"
+
+namespace ao::bench {
+    constexpr size_t ArraySize = 1 << 16;
+
+    /**
+     * @brief Create an allocator
+     *
+     * @tparam A Allocator type
+     * @param instance Instance
+     * @return std::shared_ptr<A> Allocator
+     */
+    template<class A>
+    std::shared_ptr<A> makeAllocator(test::VkInstance* instance) {
+        if constexpr (std::is_same_v<A, vulkan::DeviceAllocator>) {
+            return std::make_shared<A>(instance->device, vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+        } else {
+            return std::make_shared<A>(instance->device);
+        }
+    }
+
+    template<class A>
+    void ArrayFill(::benchmark::State& state) {
+        auto context = instance();
+        SKIP_BENCHMARK(state, !context, VULKAN_INIT_FAILURE);
+
+        vulkan::Array<ArraySize, u32> array(makeAllocator<A>(context));
+        u32 value = 0;
+
+        for (auto _ : state) {
+            array.fill(value++);
+        }
+
+        state.SetBytesProcessed(state.iterations() * ArraySize * sizeof(u32));
+    }
+    BENCHMARK_TEMPLATE(ArrayFill, vulkan::HostAllocator);
+    BENCHMARK_TEMPLATE(ArrayFill, vulkan::DeviceAllocator);
+
+    template<class A>
+    void ArrayUpload(::benchmark::State& state) {
+        auto context = instance();
+        SKIP_BENCHMARK(state, !context, VULKAN_INIT_FAILURE);
+
+        vulkan::Array<ArraySize, u32> array(makeAllocator<A>(context));
+        std::vector<u32> data(ArraySize);
+        std::iota(data.begin(), data.end(), 0);
+
+        for (auto _ : state) {
+            array.upload(data.data(), data.size());
+        }
+
+        state.SetBytesProcessed(state.iterations() * ArraySize * sizeof(u32));
+    }
+    BENCHMARK_TEMPLATE(ArrayUpload, vulkan::HostAllocator);
+    BENCHMARK_TEMPLATE(ArrayUpload, vulkan::DeviceAllocator);
+
+    template<class A>
+    void ArrayInvalidate(::benchmark::State& state) {
+        auto context = instance();
+        SKIP_BENCHMARK(state, !context, VULKAN_INIT_FAILURE);
+
+        vulkan::Array<ArraySize, u32> array(makeAllocator<A>(context));
+        auto count = static_cast<size_t>(state.range(0));
+
+        for (auto _ : state) {
+            array.invalidate(0, count);
+        }
+
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(u32));
+    }
+    BENCHMARK_TEMPLATE(ArrayInvalidate, vulkan::HostAllocator)->RangeMultiplier(16)->Range(1, ArraySize);
+    BENCHMARK_TEMPLATE(ArrayInvalidate, vulkan::DeviceAllocator)->RangeMultiplier(16)->Range(1, ArraySize);
+
+    template<class A>
+    void VectorPushBack(::benchmark::State& state) {
+        auto context = instance();
+        SKIP_BENCHMARK(state, !context, VULKAN_INIT_FAILURE);
+
+        auto allocator = makeAllocator<A>(context);
+        auto count = static_cast<size_t>(state.range(0));
+
+        for (auto _ : state) {
+            vulkan::Vector<u32> vector(0, allocator);
+
+            for (size_t i = 0; i < count; i++) {
+                vector.push_back(static_cast<u32>(i));
+            }
+            vector.invalidate(0, vector.size());
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK_TEMPLATE(VectorPushBack, vulkan::HostAllocator)->RangeMultiplier(16)->Range(16, ArraySize);
+    BENCHMARK_TEMPLATE(VectorPushBack, vulkan::DeviceAllocator)->RangeMultiplier(16)->Range(16, ArraySize);
+
+    template<class A>
+    void VectorAssign(::benchmark::State& state) {
+        auto context = instance();
+        SKIP_BENCHMARK(state, !context, VULKAN_INIT_FAILURE);
+
+        vulkan::Vector<u32> vector(ArraySize, makeAllocator<A>(context));
+        std::vector<u32> data(ArraySize);
+        std::iota(data.begin(), data.end(), 0);
+
+        for (auto _ : state) {
+            vector.assign(data.data(), data.size());
+        }
+
+        state.SetBytesProcessed(state.iterations() * ArraySize * sizeof(u32));
+    }
+    BENCHMARK_TEMPLATE(VectorAssign, vulkan::HostAllocator);
+    BENCHMARK_TEMPLATE(VectorAssign, vulkan::DeviceAllocator);
+
+    template<class A>
+    void TupleInvalidate(::benchmark::State& state) {
+        auto context = instance();
+        SKIP_BENCHMARK(state, !context, VULKAN_INIT_FAILURE);
+
+        vulkan::Tuple<u64, float, std::array<float, 16>> tuple(makeAllocator<A>(context));
+
+        for (auto _ : state) {
+            vulkan::get<0>(tuple)++;
+            tuple.invalidate(0, 3);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK_TEMPLATE(TupleInvalidate, vulkan::HostAllocator);
+    BENCHMARK_TEMPLATE(TupleInvalidate, vulkan::DeviceAllocator);
+}  // namespace ao::bench
@@ -0,0 +1,52 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#pragma once
+
+#include <memory>
+
+#include <ao/core/logging/log.h>
+#include <benchmark/benchmark.h>
+#include <boost/log/core.hpp>
+#include <boost/log/expressions.hpp>
+#include <boost/log/trivial.hpp>
+
+#include "../../tests/helpers/vk_instance.hpp"
+
+namespace ao::bench {
+/**
+ * @brief Macro to skip a benchmark
+ *
+ * @param state Benchmark's state
+ * @param condition Condition
+ * @param message Message displayed if condition is true
+ *
+ */
+#define SKIP_BENCHMARK(state, condition, message) \
+    {                                             \
+        if (condition) {                          \
+            (state).SkipWithError(#message);      \
+            return;                               \
+        }                                         \
+    }
+
+    /**
+     * @brief Get vulkan instance shared by benchmarks, validation layers are disabled.
+     * Set VK_ICD_FILENAMES to a software implementation's manifest (such as lavapipe) to run them without a GPU
+     *
+     * @return test::VkInstance* Instance, nullptr if vulkan can't be initialized
+     */
+    inline test::VkInstance* instance() {
+        static std::unique_ptr<test::VkInstance> instance = []() {
+            // 'Mute' logger
+            core::Logger::Init();
+            boost::log::core::get()->set_filter(boost::log::trivial::severity >= boost::log::trivial::fatal);
+
+            auto instance = std::make_unique<test::VkInstance>();
+            return instance->init(false) ? std::move(instance) : nullptr;
+        }();
+
+        return instance.get();
+    }
+}  // namespace ao::bench
@@ -4,25 +4,33 @@
 
 #pragma once
 
+#include <cstddef>
 #include <iterator>
+#include <type_traits>
 
 namespace ao::core {
 
     /**
-     * @brief Iterator with a pointer
+     * @brief Random-access iterator with a pointer and a stride (in bytes), elements are contiguous if stride is sizeof(T)
      *
      * @tparam T Pointer type
      */
     template<class T>
-    class PtrIterator : public std::iterator<std::input_iterator_tag, T> {
+    class PtrIterator {
        public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_cv_t<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
         /**
          * @brief Construct a new PtrIterator object
          *
          * @param pointer Pointer
          * @param stride Stride (in bytes)
          */
-        PtrIterator(T* pointer, size_t stride = sizeof(T)) : ptr(pointer), stride(stride) {}
+        PtrIterator(T* pointer = nullptr, size_t stride = sizeof(T)) : stride(stride), ptr(pointer) {}
 
         /**
          * @brief Operator++
@@ -30,9 +38,7 @@ namespace ao::core {
          * @return PtrIterator& Iterator
          */
         PtrIterator& operator++() {
-            this->ptr = reinterpret_cast<T*>(reinterpret_cast<char*>((void*)this->ptr) + this->stride);
-
-            return *this;
+            return *this += 1;
         }
 
         /**
@@ -43,10 +49,97 @@ namespace ao::core {
         PtrIterator operator++(int) {
             PtrIterator tmp(*this);
 
-            (*this)++;
+            ++(*this);
+            return tmp;
+        }
+
+        /**
+         * @brief Operator--
+         *
+         * @return PtrIterator& Iterator
+         */
+        PtrIterator& operator--() {
+            return *this -= 1;
+        }
+
+        /**
+         * @brief Operator--()
+         *
+         * @return PtrIterator Iterator
+         */
+        PtrIterator operator--(int) {
+            PtrIterator tmp(*this);
+
+            --(*this);
             return tmp;
         }
 
+        /**
+         * @brief Operator+=
+         *
+         * @param n Count of elements
+         * @return PtrIterator& Iterator
+         */
+        PtrIterator& operator+=(difference_type n) {
+            auto bytes = reinterpret_cast<char*>(const_cast<value_type*>(this->ptr));
+
+            this->ptr = reinterpret_cast<T*>(bytes + n * static_cast<difference_type>(this->stride));
+
+            return *this;
+        }
+
+        /**
+         * @brief Operator-=
+         *
+         * @param n Count of elements
+         * @return PtrIterator& Iterator
+         */
+        PtrIterator& operator-=(difference_type n) {
+            return *this += -n;
+        }
+
+        /**
+         * @brief Operator+
+         *
+         * @param n Count of elements
+         * @return PtrIterator Iterator
+         */
+        PtrIterator operator+(difference_type n) const {
+            return PtrIterator(*this) += n;
+        }
+
+        /**
+         * @brief Operator+
+         *
+         * @param n Count of elements
+         * @param iterator Iterator
+         * @return PtrIterator Iterator
+         */
+        friend PtrIterator operator+(difference_type n, PtrIterator const& iterator) {
+            return iterator + n;
+        }
+
+        /**
+         * @brief Operator-
+         *
+         * @param n Count of elements
+         * @return PtrIterator Iterator
+         */
+        PtrIterator operator-(difference_type n) const {
+            return PtrIterator(*this) -= n;
+        }
+
+        /**
+         * @brief Operator-
+         *
+         * @param iterator Iterator
+         * @return difference_type Count of elements between iterators
+         */
+        difference_type operator-(PtrIterator const& iterator) const {
+            return (reinterpret_cast<char const*>(this->ptr) - reinterpret_cast<char const*>(iterator.ptr)) /
+                   static_cast<difference_type>(this->stride);
+        }
+
         /**
          * @brief Operator==
          *
@@ -69,15 +162,98 @@ namespace ao::core {
             return this->ptr != iterator.ptr;
         }
 
+        /**
+         * @brief Operator<
+         *
+         * @param iterator Iterator
+         * @return true Iterator is before {iterator}
+         * @return false Iterator isn't before {iterator}
+         */
+        bool operator<(PtrIterator const& iterator) const {
+            return this->ptr < iterator.ptr;
+        }
+
+        /**
+         * @brief Operator>
+         *
+         * @param iterator Iterator
+         * @return true Iterator is after {iterator}
+         * @return false Iterator isn't after {iterator}
+         */
+        bool operator>(PtrIterator const& iterator) const {
+            return iterator < *this;
+        }
+
+        /**
+         * @brief Operator<=
+         *
+         * @param iterator Iterator
+         * @return true Iterator isn't after {iterator}
+         * @return false Iterator is after {iterator}
+         */
+        bool operator<=(PtrIterator const& iterator) const {
+            return !(iterator < *this);
+        }
+
+        /**
+         * @brief Operator>=
+         *
+         * @param iterator Iterator
+         * @return true Iterator isn't before {iterator}
+         * @return false Iterator is before {iterator}
+         */
+        bool operator>=(PtrIterator const& iterator) const {
+            return !(*this < iterator);
+        }
+
         /**
          * @brief Operator*
          *
          * @return T& Value
          */
-        T& operator*() {
+        T& operator*() const {
             return *this->ptr;
         }
 
+        /**
+         * @brief Operator->
+         *
+         * @return T* Pointer
+         */
+        T* operator->() const {
+            return this->ptr;
+        }
+
+        /**
+         * @brief Operator[]
+         *
+         * @param n Index
+         * @return T& Value
+         */
+        T& operator[](difference_type n) const {
+            return *(*this + n);
+        }
+
+        /**
+         * @brief Get pointer
+         *
+         * @return T* Pointer
+         */
+        T* get() const {
+            return this->ptr;
+        }
+
+        /**
+         * @brief Check if elements are contiguous, then [get(), get() + n) can be used as a plain array (fast path for
+         * auto-vectorization and parallel algorithms)
+         *
+         * @return true Elements are contiguous
+         * @return false Elements are strided
+         */
+        bool contiguous() const {
+            return this->stride == sizeof(T);
+        }
+
        protected:
         size_t stride;
         T* ptr;
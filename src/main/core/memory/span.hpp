@@ -0,0 +1,113 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace ao::core {
+    /**
+     * @brief Non-owning view on {size} contiguous elements (C++17 stand-in for std::span)
+     *
+     * @tparam T Type of elements
+     */
+    template<class T>
+    class Span {
+       public:
+        using element_type = T;
+        using iterator = T*;
+
+        /**
+         * @brief Construct a new Span object
+         *
+         * @param data Pointer to first element
+         * @param size Count of elements
+         */
+        constexpr Span(T* data = nullptr, size_t size = 0) : data_(data), size_(size) {}
+
+        /**
+         * @brief Operator[]
+         *
+         * @param index Index
+         * @return T& Value
+         */
+        constexpr T& operator[](size_t index) const {
+            return this->data_[index];
+        }
+
+        /**
+         * @brief Get pointer to first element
+         *
+         * @return T* Pointer
+         */
+        constexpr T* data() const {
+            return this->data_;
+        }
+
+        /**
+         * @brief Get count of elements
+         *
+         * @return size_t Count
+         */
+        constexpr size_t size() const {
+            return this->size_;
+        }
+
+        /**
+         * @brief Get size of elements (in bytes)
+         *
+         * @return size_t Size
+         */
+        constexpr size_t sizeBytes() const {
+            return this->size_ * sizeof(T);
+        }
+
+        /**
+         * @brief Check if span is empty
+         *
+         * @return true Span is empty
+         * @return false Span isn't empty
+         */
+        constexpr bool empty() const {
+            return this->size_ == 0;
+        }
+
+        /**
+         * @brief Get a view on {count} elements from {offset}
+         *
+         * @param offset Offset (in elements)
+         * @param count Count of elements
+         * @return Span Sub-span
+         */
+        Span subspan(size_t offset, size_t count) const {
+            if (offset > this->size_ || count > this->size_ - offset) {
+                throw std::out_of_range("Sub-span is out of span");
+            }
+            return Span(this->data_ + offset, count);
+        }
+
+        /**
+         * @brief Get begin iterator
+         *
+         * @return iterator Iterator
+         */
+        constexpr iterator begin() const {
+            return this->data_;
+        }
+
+        /**
+         * @brief Get end iterator
+         *
+         * @return iterator Iterator
+         */
+        constexpr iterator end() const {
+            return this->data_ + this->size_;
+        }
+
+       protected:
+        T* data_;
+        size_t size_;
+    };
+}  // namespace ao::core
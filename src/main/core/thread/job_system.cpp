@@ -0,0 +1,201 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include "job_system.h"
+
+namespace {
+    /**
+     * @brief Job system of current thread, nullptr if it isn't a worker
+     *
+     */
+    thread_local ao::core::JobSystem const* worker_system = nullptr;
+
+    /**
+     * @brief Worker's index of current thread
+     *
+     */
+    thread_local size_t worker_index = 0;
+}  // namespace
+
+ao::core::JobSystem::JobSystem(u32 threads) : next_queue(0), queued(0), stop(false) {
+    // Define count of workers
+    if (threads == 0) {
+        threads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    }
+
+    // Create deques
+    this->queues.resize(threads);
+    for (auto& queue : this->queues) {
+        queue = std::make_unique<Queue>();
+    }
+
+    // Start workers
+    this->threads.reserve(threads);
+    for (size_t i = 0; i < threads; i++) {
+        this->threads.emplace_back(&ao::core::JobSystem::work, this, i);
+    }
+}
+
+ao::core::JobSystem::~JobSystem() {
+    // Stop workers
+    {
+        std::lock_guard lock(this->mutex);
+        this->stop = true;
+    }
+    this->condition.notify_all();
+
+    for (auto& thread : this->threads) {
+        thread.join();
+    }
+}
+
+std::shared_ptr<ao::core::JobSystem> ao::core::JobSystem::Shared() {
+    static std::shared_ptr<ao::core::JobSystem> system = std::make_shared<ao::core::JobSystem>();
+
+    return system;
+}
+
+std::shared_ptr<ao::core::JobCounter> ao::core::JobSystem::schedule(Job job, std::shared_ptr<JobCounter> counter,
+                                                                    std::shared_ptr<JobCounter> const& dependency) {
+    if (!counter) {
+        counter = std::make_shared<ao::core::JobCounter>();
+    }
+    counter->value.fetch_add(1, std::memory_order_acq_rel);
+
+    // Defer job until dependency is done
+    if (dependency) {
+        std::lock_guard lock(dependency->mutex);
+
+        if (!dependency->done()) {
+            dependency->continuations.emplace_back(std::move(job), counter);
+            return counter;
+        }
+    }
+
+    this->push({std::move(job), counter});
+    return counter;
+}
+
+void ao::core::JobSystem::wait(std::shared_ptr<JobCounter> const& counter) {
+    // Help workers
+    while (!counter->done()) {
+        Task task;
+
+        if (this->pop(task)) {
+            this->run(task);
+            continue;
+        }
+
+        // Sleep until a task is pushed or counter reaches zero
+        std::unique_lock lock(this->mutex);
+        this->condition.wait(lock, [this, &counter]() { return counter->done() || this->queued.load(std::memory_order_acquire) > 0; });
+    }
+
+    // Pass on a wake-up that may have been meant for a worker
+    if (this->queued.load(std::memory_order_acquire) > 0) {
+        this->condition.notify_one();
+    }
+
+    // Rethrow job's exception
+    std::lock_guard lock(counter->mutex);
+    if (counter->error) {
+        std::rethrow_exception(std::exchange(counter->error, nullptr));
+    }
+}
+
+void ao::core::JobSystem::push(Task task) {
+    size_t index = worker_system == this ? worker_index : this->next_queue.fetch_add(1, std::memory_order_relaxed) % this->queues.size();
+
+    // Push task
+    {
+        std::lock_guard lock(this->queues[index]->mutex);
+        this->queues[index]->tasks.push_back(std::move(task));
+    }
+    this->queued.fetch_add(1, std::memory_order_release);
+
+    // Wake a worker
+    {
+        std::lock_guard lock(this->mutex);
+    }
+    this->condition.notify_one();
+}
+
+bool ao::core::JobSystem::pop(Task& task) {
+    size_t first = worker_system == this ? worker_index : 0;
+
+    // Pop own task, otherwise steal one
+    for (size_t i = 0; i < this->queues.size(); i++) {
+        auto& queue = *this->queues[(first + i) % this->queues.size()];
+        std::lock_guard lock(queue.mutex);
+
+        if (!queue.tasks.empty()) {
+            if (i == 0 && worker_system == this) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            } else {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            this->queued.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ao::core::JobSystem::run(Task& task) {
+    auto counter = task.counter;
+
+    // Execute job
+    try {
+        task.job();
+    } catch (...) {
+        std::lock_guard lock(counter->mutex);
+
+        if (!counter->error) {
+            counter->error = std::current_exception();
+        }
+    }
+    task = Task();
+
+    // Schedule jobs depending on counter
+    if (counter->value.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::vector<std::pair<Job, std::shared_ptr<JobCounter>>> continuations;
+        {
+            std::lock_guard lock(counter->mutex);
+            continuations.swap(counter->continuations);
+        }
+
+        for (auto& [job, job_counter] : continuations) {
+            this->push({std::move(job), job_counter});
+        }
+
+        // Wake threads waiting counter
+        {
+            std::lock_guard lock(this->mutex);
+        }
+        this->condition.notify_all();
+    }
+}
+
+void ao::core::JobSystem::work(size_t index) {
+    worker_system = this;
+    worker_index = index;
+
+    while (true) {
+        Task task;
+
+        if (this->pop(task)) {
+            this->run(task);
+            continue;
+        }
+
+        // Sleep until a task is pushed
+        std::unique_lock lock(this->mutex);
+        if (this->stop && this->queued.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+        this->condition.wait(lock, [this]() { return this->stop || this->queued.load(std::memory_order_acquire) > 0; });
+    }
+}
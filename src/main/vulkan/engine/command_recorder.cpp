@@ -0,0 +1,73 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include "command_recorder.h"
+
+#include <algorithm>
+
+#include <ao/core/exception/exception.h>
+#include <fmt/format.h>
+
+ao::vulkan::CommandRecorder::CommandRecorder(std::shared_ptr<Device> device, u32 frames, u32 slices, size_t min_slice,
+                                             std::shared_ptr<core::JobSystem> jobs)
+    : jobs(jobs ? jobs : ao::core::JobSystem::Shared()), device(device), min_slice(std::max<size_t>(min_slice, 1)), frames(frames) {
+    if (frames == 0) {
+        throw ao::core::Exception("CommandRecorder needs at least one frame");
+    }
+
+    // Define count of slices
+    if (slices == 0) {
+        slices = static_cast<u32>(this->jobs->size() + 1);
+    }
+
+    // Create command pools & buffers
+    u32 family_index = this->device->queues()->at(vk::to_string(vk::QueueFlagBits::eGraphics)).family_index;
+    this->slices.resize(slices);
+    for (auto& slice : this->slices) {
+        for (u32 i = 0; i < frames; i++) {
+            slice.pools.push_back(
+                std::make_unique<ao::vulkan::CommandPool>(this->device->logical(), vk::CommandPoolCreateFlagBits::eResetCommandBuffer, family_index));
+            slice.commands.push_back(slice.pools.back()->allocateCommandBuffers(vk::CommandBufferLevel::eSecondary, 1).front());
+        }
+    }
+}
+
+void ao::vulkan::CommandRecorder::record(u32 frame, vk::CommandBuffer primary, vk::CommandBufferInheritanceInfo const& inheritance, size_t count,
+                                         RecordFunction const& function) {
+    if (frame >= this->frames) {
+        throw ao::core::Exception(fmt::format("Frame {} is out of range [0, {})", frame, this->frames));
+    }
+    if (count == 0) {
+        return;
+    }
+
+    // Split draws into slices
+    size_t slices = std::min(this->slices.size(), (count + this->min_slice - 1) / this->min_slice);
+    size_t slice_size = (count + slices - 1) / slices;
+    slices = (count + slice_size - 1) / slice_size;
+
+    // Record slices in parallel
+    this->jobs->parallelFor(
+        0, slices,
+        [&](size_t first, size_t last) {
+            for (size_t i = first; i < last; i++) {
+                auto command = this->slices[i].commands[frame];
+                size_t begin = i * slice_size;
+
+                command.begin(vk::CommandBufferBeginInfo(
+                    vk::CommandBufferUsageFlagBits::eOneTimeSubmit | vk::CommandBufferUsageFlagBits::eRenderPassContinue, &inheritance));
+                function(command, begin, std::min(count, begin + slice_size));
+                command.end();
+            }
+        },
+        1);
+
+    // Execute secondary command buffers in order
+    std::vector<vk::CommandBuffer> commands;
+    commands.reserve(slices);
+    for (size_t i = 0; i < slices; i++) {
+        commands.push_back(this->slices[i].commands[frame]);
+    }
+    primary.executeCommands(commands);
+}
@@ -0,0 +1,92 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <ao/core/thread/job_system.h>
+#include <ao/core/utilities/types.h>
+#include <vulkan/vulkan.hpp>
+
+#include "../wrapper/command_pool.h"
+#include "../wrapper/device.h"
+
+namespace ao::vulkan {
+    /**
+     * @brief Records secondary command buffers in parallel on a job system: a draw list is split into slices,
+     * each slice is recorded into its own command buffer and primary command buffer executes them in order.
+     * Each slice owns a command pool per frame, so a frame's buffers are re-recorded only once its fence is waited
+     *
+     */
+    class CommandRecorder {
+       public:
+        /**
+         * @brief Function recording draws [begin, end) into a secondary command buffer, it's called from several threads at once
+         *
+         */
+        using RecordFunction = std::function<void(vk::CommandBuffer command, size_t begin, size_t end)>;
+
+        /**
+         * @brief Construct a new CommandRecorder object
+         *
+         * @param device Device
+         * @param frames Count of frames in flight
+         * @param slices Maximal count of slices, 0 to use a slice per thread of job system
+         * @param min_slice Minimal count of draws in a slice, so that small lists aren't split
+         * @param jobs Job system, shared one if it's nullptr
+         */
+        CommandRecorder(std::shared_ptr<Device> device, u32 frames, u32 slices = 0, size_t min_slice = 256,
+                        std::shared_ptr<core::JobSystem> jobs = nullptr);
+        CommandRecorder(CommandRecorder const&) = delete;
+
+        /**
+         * @brief Destroy the CommandRecorder object
+         *
+         */
+        virtual ~CommandRecorder() = default;
+
+        /**
+         * @brief Record {count} draws of {frame} into secondary command buffers, then execute them in {primary}.
+         * {primary} must be in a render pass begun with vk::SubpassContents::eSecondaryCommandBuffers
+         *
+         * @param frame Frame index
+         * @param primary Primary command buffer
+         * @param inheritance Inheritance info (render pass, subpass, framebuffer)
+         * @param count Count of draws
+         * @param function Record function
+         */
+        void record(u32 frame, vk::CommandBuffer primary, vk::CommandBufferInheritanceInfo const& inheritance, size_t count,
+                    RecordFunction const& function);
+
+        /**
+         * @brief Get maximal count of slices
+         *
+         * @return size_t Count
+         */
+        size_t size() const {
+            return this->slices.size();
+        }
+
+        CommandRecorder& operator=(CommandRecorder const&) = delete;
+
+       protected:
+        /**
+         * @brief Slice, a command pool and a secondary command buffer per frame
+         *
+         */
+        struct Slice {
+            std::vector<std::unique_ptr<CommandPool>> pools;
+            std::vector<vk::CommandBuffer> commands;
+        };
+
+        std::shared_ptr<core::JobSystem> jobs;
+        std::shared_ptr<Device> device;
+        std::vector<Slice> slices;
+        size_t min_slice;
+        u32 frames;
+    };
+}  // namespace ao::vulkan
@@ -4,7 +4,8 @@
 
 #include "engine.h"
 
-ao::vulkan::Engine::Engine(std::shared_ptr<EngineSettings> settings) : settings_(settings), enforce_resize(false), current_frame(0) {}
+ao::vulkan::Engine::Engine(std::shared_ptr<EngineSettings> settings)
+    : settings_(settings), enforce_resize(false), frames_in_flight(0), current_frame(0) {}
 
 void ao::vulkan::Engine::run() {
     // Init window
@@ -49,16 +50,34 @@ void ao::vulkan::Engine::initVulkan() {
 
     LOG_MSG(info) << fmt::format("Select physical device: {0}", this->device->physical().getProperties().deviceName);
 
+    // Enable timeline semaphores
+    auto extensions = this->deviceExtensions();
+    if (this->settings_->get(ao::vulkan::settings::TimelineSemaphores, std::make_optional(false))) {
+        if (ao::vulkan::timelineSemaphoreSupported(this->device->physical())) {
+            extensions.push_back(ao::vulkan::timeline::ExtensionName);
+        } else {
+            LOG_MSG(warning) << "Timeline semaphores aren't supported, frames are synchronized with fences";
+        }
+    }
+
     // Init logical device
-    this->device->initLogicalDevice(this->deviceExtensions(), this->deviceFeatures(), this->requestQueues());
+    this->device->initLogicalDevice(extensions, this->deviceFeatures(), this->requestQueues());
 
     // Create swapChain
-    this->swapchain = std::make_shared<ao::vulkan::Swapchain>(this->instance, this->device);
+    this->swapchain = this->createSwapchain();
+}
+
+std::shared_ptr<ao::vulkan::Swapchain> ao::vulkan::Engine::createSwapchain() {
+    return std::make_shared<ao::vulkan::Swapchain>(this->instance, this->device);
 }
 
 void ao::vulkan::Engine::freeVulkan() {
     this->swapchain.reset();
 
+    this->command_recorder.reset();
+
+    this->frame_allocator.reset();
+
     this->pipelines.clear();
 
     this->device->logical()->destroyRenderPass(this->render_pass);
@@ -67,6 +86,8 @@ void ao::vulkan::Engine::freeVulkan() {
         this->device->logical()->destroyFence(fence);
     }
 
+    this->timeline.reset();
+
     this->semaphores->clear();
 
     this->device.reset();
@@ -102,6 +123,10 @@ void ao::vulkan::Engine::recreateSwapChain() {
     // Create framebuffers
     this->swapchain->createFramebuffers(this->render_pass);
 
+    // Images changed, none is used
+    this->image_fences.assign(this->swapchain->size(), vk::Fence());
+    this->image_values.assign(this->swapchain->size(), 0);
+
     // Call onSwapchainRecreation()
     this->onSwapchainRecreation();
 
@@ -113,23 +138,32 @@ void ao::vulkan::Engine::createSemaphores() {
     this->semaphores = std::make_unique<ao::vulkan::SemaphoreContainer>(this->device->logical());
 
     // Create semaphores
-    this->semaphores->resize(3 * this->swapchain->size());
-    for (size_t i = 0; i < this->swapchain->size(); i++) {
+    this->semaphores->resize(3 * this->frames_in_flight);
+    for (size_t i = 0; i < this->frames_in_flight; i++) {
         vk::Semaphore acquire = this->device->logical()->createSemaphore(vk::SemaphoreCreateInfo());
         vk::Semaphore render = this->device->logical()->createSemaphore(vk::SemaphoreCreateInfo());
 
         // Fill container
-        this->semaphores->at(ao::vulkan::semaphore::AcquireImage * this->swapchain->size() + i).signals.push_back(acquire);
+        this->semaphores->at(ao::vulkan::semaphore::AcquireImage * this->frames_in_flight + i).signals.push_back(acquire);
 
-        this->semaphores->at(ao::vulkan::semaphore::GraphicProcess * this->swapchain->size() + i).waits.push_back(acquire);
-        this->semaphores->at(ao::vulkan::semaphore::GraphicProcess * this->swapchain->size() + i).signals.push_back(render);
+        this->semaphores->at(ao::vulkan::semaphore::GraphicProcess * this->frames_in_flight + i).waits.push_back(acquire);
+        this->semaphores->at(ao::vulkan::semaphore::GraphicProcess * this->frames_in_flight + i).signals.push_back(render);
 
-        this->semaphores->at(ao::vulkan::semaphore::PresentImage * this->swapchain->size() + i).waits.push_back(render);
+        this->semaphores->at(ao::vulkan::semaphore::PresentImage * this->frames_in_flight + i).waits.push_back(render);
     }
 }
 
 void ao::vulkan::Engine::createFences() {
-    this->fences.resize(this->swapchain->size());
+    // Replace fences by a timeline semaphore
+    if (this->device->extensionEnabled(ao::vulkan::timeline::ExtensionName)) {
+        this->timeline = std::make_unique<ao::vulkan::TimelineSemaphore>(this->device->logical());
+        this->frame_values.assign(this->frames_in_flight, 0);
+        this->image_values.assign(this->swapchain->size(), 0);
+        return;
+    }
+
+    this->fences.resize(this->frames_in_flight);
+    this->image_fences.assign(this->swapchain->size(), vk::Fence());
 
     for (auto& fence : this->fences) {
         fence = this->device->logical()->createFence(vk::FenceCreateInfo(vk::FenceCreateFlagBits::eSignaled));
@@ -146,12 +180,28 @@ void ao::vulkan::Engine::prepareVulkan() {
                           this->settings_->get(ao::vulkan::settings::WindowVsync, std::make_optional(false)),
                           this->settings_->get(ao::vulkan::settings::StencilBuffer, std::make_optional(false)));
 
+    // Define frames in flight
+    this->frames_in_flight = this->settings_->get(ao::vulkan::settings::FramesInFlight, std::make_optional<u32>(2));
+    if (this->frames_in_flight == 0) {
+        throw ao::core::Exception("Engine needs at least one frame in flight");
+    }
+
     // Create semaphores
     this->createSemaphores();
 
     // Create fences
     this->createFences();
 
+    // Create allocator of per-frame data
+    if (auto size = this->settings_->get(ao::vulkan::settings::FrameAllocatorSize, std::make_optional<u64>(0))) {
+        this->frame_allocator = std::make_shared<ao::vulkan::LinearAllocator>(this->device, this->frames_in_flight, size);
+    }
+
+    // Create recorder of secondary command buffers
+    if (auto slices = this->settings_->get(ao::vulkan::settings::RecordingSlices, std::make_optional<u32>(0))) {
+        this->command_recorder = std::make_unique<ao::vulkan::CommandRecorder>(this->device, this->frames_in_flight, slices);
+    }
+
     // Create render pass
     if (!(this->render_pass = this->createRenderPass())) {
         throw ao::core::Exception("Render pass isn't initialized");
@@ -180,14 +230,21 @@ void ao::vulkan::Engine::loop() {
 
 void ao::vulkan::Engine::render() {
     vk::PipelineStageFlags pipeline_stage = vk::PipelineStageFlagBits::eColorAttachmentOutput;
-    vk::Fence fence = this->fences[this->current_frame];
 
-    // Wait fence
-    this->device->logical()->waitForFences(fence, VK_TRUE, (std::numeric_limits<u64>::max)());
+    // Wait frame
+    this->waitFrame(this->current_frame);
+
+    // Release frame's transient data
+    if (this->frame_allocator) {
+        this->frame_allocator->reset(this->current_frame);
+    }
 
     // Prepare frame
     this->prepareFrame();
 
+    // Wait previous frame that used image
+    this->waitImage(this->swapchain->frameIndex());
+
     // Call	beforeCommandBuffersUpdate()
     this->beforeCommandBuffersUpdate();
 
@@ -195,29 +252,93 @@ void ao::vulkan::Engine::render() {
     this->updateCommandBuffers();
 
     // Create submit info
-    auto sem_index = (ao::vulkan::semaphore::GraphicProcess * this->swapchain->size()) + this->current_frame;
+    auto sem_index = (ao::vulkan::semaphore::GraphicProcess * this->frames_in_flight) + this->current_frame;
     vk::SubmitInfo submit_info(static_cast<u32>(this->semaphores->at(sem_index).waits.size()),
                                this->semaphores->at(sem_index).waits.empty() ? nullptr : this->semaphores->at(sem_index).waits.data(),
                                &pipeline_stage, 1, &this->swapchain->currentCommand(),
                                static_cast<u32>(this->semaphores->at(sem_index).signals.size()),
                                this->semaphores->at(sem_index).signals.empty() ? nullptr : this->semaphores->at(sem_index).signals.data());
 
-    // Reset fence
-    this->device->logical()->resetFences(fence);
-
     // Submit command buffer
-    this->device->queues()->at(vk::to_string(vk::QueueFlagBits::eGraphics)).value.submit(submit_info, fence);
+    this->submitCommands(submit_info);
 
     // Submit frame
     this->submitFrame();
 
     // Increment frame index
-    this->current_frame = (this->current_frame + 1) % this->swapchain->size();
+    this->current_frame = (this->current_frame + 1) % this->frames_in_flight;
+}
+
+void ao::vulkan::Engine::waitFrame(u32 frame) {
+    if (this->timeline) {
+        this->timeline->wait(this->frame_values[frame]);
+        return;
+    }
+
+    this->device->logical()->waitForFences(this->fences[frame], VK_TRUE, (std::numeric_limits<u64>::max)());
+}
+
+void ao::vulkan::Engine::waitImage(u32 image) {
+    if (this->timeline) {
+        if (image < this->image_values.size()) {
+            this->timeline->wait(this->image_values[image]);
+
+            // Current frame signals next value
+            this->image_values[image] = this->timeline->target() + 1;
+        }
+        return;
+    }
+
+    if (image < this->image_fences.size()) {
+        vk::Fence fence = this->fences[this->current_frame];
+        auto& image_fence = this->image_fences[image];
+
+        if (image_fence && image_fence != fence) {
+            this->device->logical()->waitForFences(image_fence, VK_TRUE, (std::numeric_limits<u64>::max)());
+        }
+        image_fence = fence;
+    }
+}
+
+void ao::vulkan::Engine::submitCommands(vk::SubmitInfo submit_info) {
+    auto& queue = this->device->queues()->at(vk::to_string(vk::QueueFlagBits::eGraphics)).value;
+
+    // Signal frame's value
+    if (this->timeline) {
+        this->frame_values[this->current_frame] = this->timeline->next();
+        this->timeline->submit(queue, submit_info, this->frame_values[this->current_frame]);
+        return;
+    }
+
+    // Reset fence
+    vk::Fence fence = this->fences[this->current_frame];
+    this->device->logical()->resetFences(fence);
+
+    queue.submit(submit_info, fence);
+}
+
+void ao::vulkan::Engine::recordParallel(vk::RenderPassBeginInfo const& begin_info, size_t count,
+                                        ao::vulkan::CommandRecorder::RecordFunction const& function) {
+    if (!this->command_recorder) {
+        throw ao::core::Exception(fmt::format("Command recorder is disabled, set {} to enable it", ao::vulkan::settings::RecordingSlices));
+    }
+    auto& command = this->swapchain->currentCommand();
+
+    // Record primary command buffer
+    command.begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+    command.beginRenderPass(begin_info, vk::SubpassContents::eSecondaryCommandBuffers);
+
+    // Record draws in parallel
+    this->command_recorder->record(this->current_frame, command,
+                                   vk::CommandBufferInheritanceInfo(begin_info.renderPass, 0, begin_info.framebuffer), count, function);
+
+    command.endRenderPass();
+    command.end();
 }
 
 void ao::vulkan::Engine::prepareFrame() {
     vk::Result result = this->swapchain->acquireNextImage(
-        this->semaphores->at(ao::vulkan::semaphore::AcquireImage * this->swapchain->size() + this->current_frame).signals.front());
+        this->semaphores->at(ao::vulkan::semaphore::AcquireImage * this->frames_in_flight + this->current_frame).signals.front());
 
     // Check result
     if (result == vk::Result::eErrorOutOfDateKHR || result == vk::Result::eSuboptimalKHR || this->enforce_resize) {
@@ -231,7 +352,7 @@ void ao::vulkan::Engine::prepareFrame() {
 
 void ao::vulkan::Engine::submitFrame() {
     vk::Result result = this->swapchain->enqueueImage(
-        this->semaphores->at(ao::vulkan::semaphore::PresentImage * this->swapchain->size() + this->current_frame).waits);
+        this->semaphores->at(ao::vulkan::semaphore::PresentImage * this->frames_in_flight + this->current_frame).waits);
 
     // Check result
     if (result == vk::Result::eErrorOutOfDateKHR || result == vk::Result::eSuboptimalKHR || this->enforce_resize) {
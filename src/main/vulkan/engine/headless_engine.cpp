@@ -0,0 +1,60 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include "headless_engine.h"
+
+ao::vulkan::HeadlessEngine::HeadlessEngine(std::shared_ptr<EngineSettings> settings) : ao::vulkan::Engine(settings) {}
+
+void ao::vulkan::HeadlessEngine::run() {
+    LOG_MSG(info) << fmt::format("Init {0}x{1} headless engine", this->settings_->get<u32>(ao::vulkan::settings::SurfaceWidth),
+                                 this->settings_->get<u32>(ao::vulkan::settings::SurfaceHeight));
+
+    // Init vulkan
+    this->initVulkan();
+    this->prepareVulkan();
+
+    // Execute main loop
+    this->loop();
+
+    // Free vulkan
+    this->freeVulkan();
+}
+
+std::vector<u8> ao::vulkan::HeadlessEngine::readFrame() {
+    // Check state
+    if (this->swapchain->state() == ao::vulkan::SwapchainState::eIdle) {
+        throw ao::core::Exception("No frame is rendered");
+    }
+
+    // Wait frame
+    u32 frame = (this->current_frame + this->frames_in_flight - 1) % this->frames_in_flight;
+    this->waitFrame(frame);
+
+    return std::static_pointer_cast<ao::vulkan::OffscreenSwapchain>(this->swapchain)->read(this->swapchain->frameIndex());
+}
+
+std::shared_ptr<ao::vulkan::Swapchain> ao::vulkan::HeadlessEngine::createSwapchain() {
+    return std::make_shared<ao::vulkan::OffscreenSwapchain>(this->instance, this->device,
+                                                            this->settings_->get(ao::vulkan::settings::HeadlessImages, std::make_optional<u32>(3)));
+}
+
+void ao::vulkan::HeadlessEngine::createSemaphores() {
+    this->semaphores = std::make_unique<ao::vulkan::SemaphoreContainer>(this->device->logical());
+
+    // Images are never presented: only create empty entries (no vk::Semaphore), as render() indexes them per frame,
+    // so it finds no semaphore to wait or signal
+    this->semaphores->resize(3 * this->frames_in_flight);
+}
+
+void ao::vulkan::HeadlessEngine::prepareFrame() {
+    this->swapchain->acquireNextImage(vk::Semaphore());
+
+    // Check resize
+    if (this->enforce_resize) {
+        LOG_MSG(warning) << "Offscreen images are no longer compatible, re-create them";
+
+        this->enforce_resize = false;
+        this->recreateSwapChain();
+    }
+}
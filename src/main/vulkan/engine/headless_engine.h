@@ -0,0 +1,73 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#pragma once
+
+#include <vector>
+
+#include "../wrapper/offscreen_swapchain.h"
+#include "engine.h"
+
+namespace ao::vulkan {
+    /**
+     * @brief Engine without window: frames are rendered into a ring of offscreen images (see OffscreenSwapchain)
+     * and are never presented, so rendering isn't throttled by a present mode. Count of images is set by settings::HeadlessImages
+     *
+     */
+    class HeadlessEngine : public Engine {
+       public:
+        /**
+         * @brief Construct a new HeadlessEngine object
+         *
+         * @param settings Settings
+         */
+        explicit HeadlessEngine(std::shared_ptr<EngineSettings> settings);
+
+        /**
+         * @brief Destroy the HeadlessEngine object
+         *
+         */
+        virtual ~HeadlessEngine() = default;
+
+        /**
+         * @brief Run engine
+         *
+         */
+        virtual void run() override;
+
+        /**
+         * @brief Read last submitted frame back to host, waits until it's rendered
+         *
+         * @return std::vector<u8> Pixels (tightly packed RGBA8)
+         */
+        std::vector<u8> readFrame();
+
+       protected:
+        virtual std::shared_ptr<Swapchain> createSwapchain() override;
+        virtual void createSemaphores() override;
+        virtual void prepareFrame() override;
+
+        virtual vk::SurfaceKHR createSurface() override {
+            return vk::SurfaceKHR();
+        }
+
+        virtual void initWindow() override {}
+
+        virtual void freeWindow() override {}
+
+        virtual bool isIconified() const override {
+            return false;
+        }
+
+        virtual void waitMaximized() override {}
+
+        virtual std::vector<char const*> instanceExtensions() const override {
+            return {};
+        }
+
+        virtual std::vector<char const*> deviceExtensions() const override {
+            return {};
+        }
+    };
+}  // namespace ao::vulkan
@@ -26,6 +26,12 @@ namespace ao::vulkan {
 
         static constexpr char const* ValidationLayers = "vulkan.validation_layers";
         static constexpr char const* StencilBuffer = "vulkan.stencil_buffer";
+        static constexpr char const* FrameAllocatorSize = "vulkan.frame_allocator_size";
+        static constexpr char const* FramesInFlight = "vulkan.frames_in_flight";
+        static constexpr char const* RecordingSlices = "vulkan.recording_slices";
+        static constexpr char const* TimelineSemaphores = "vulkan.timeline_semaphores";
+
+        static constexpr char const* HeadlessImages = "headless.images";
     };  // namespace settings
 
     /**
@@ -0,0 +1,120 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#pragma once
+
+#include <array>
+#include <tuple>
+
+#include <ao/core/exception/exception.h>
+#include <ao/core/utilities/memory.h>
+#include <fmt/format.h>
+
+#include "allocator/allocator.h"
+#include "buffer.h"
+
+namespace ao::vulkan {
+    /**
+     * @brief Vulkan buffer with tuple interface whose offsets are known at compile time.
+     * {Alignment} must be a multiple of allocator's alignment
+     *
+     * @tparam Alignment Alignment of elements
+     * @tparam T Types
+     */
+    template<size_t Alignment, class... T>
+    class AlignedTuple : public Buffer {
+       public:
+        /**
+         * @brief Offsets of elements, last one is tuple's size
+         *
+         */
+        static constexpr std::array<vk::DeviceSize, sizeof...(T) + 1> Offsets = [] {
+            std::array<vk::DeviceSize, sizeof...(T) + 1> offsets{};
+            size_t sizes[] = {core::utilities::calculateAligmentSize(sizeof(T), Alignment)...};
+
+            for (size_t i = 0; i < sizeof...(T); i++) {
+                offsets[i + 1] = offsets[i] + sizes[i];
+            }
+            return offsets;
+        }();
+
+        /**
+         * @brief Construct a new AlignedTuple object
+         *
+         * @param allocator Allocator
+         * @param usage Buffer usage
+         */
+        AlignedTuple(std::shared_ptr<Allocator> allocator, vk::BufferUsageFlags usage = vk::BufferUsageFlags())
+            : Buffer(allocator, Offsets.back(), usage) {
+            // Check alignment
+            if (core::utilities::calculateAligmentSize(1, Alignment) % allocator->alignSize(1) != 0) {
+                throw core::Exception(fmt::format("Alignment {} isn't compatible with allocator's alignment {}", Alignment, allocator->alignSize(1)));
+            }
+        }
+
+        /**
+         * @brief Destroy the AlignedTuple object
+         *
+         */
+        virtual ~AlignedTuple() = default;
+
+        /**
+         * @brief Get offset of object at index {index} in info().buffer, to bind it
+         *
+         * @param index Index
+         * @return vk::DeviceSize Offset
+         */
+        vk::DeviceSize offset(size_t index) const {
+            return this->buffer_info->offset + Offsets[index];
+        }
+
+        /**
+         * @brief Get offset of object at index {index} from start of allocation (info().ptr)
+         *
+         * @param index Index
+         * @return vk::DeviceSize Offset
+         */
+        static constexpr vk::DeviceSize relativeOffset(size_t index) {
+            return Offsets[index];
+        }
+
+        /**
+         * @brief Invalidate {count} objects from {index}
+         *
+         * @param index Index
+         * @param count Count
+         */
+        void invalidate(size_t index, size_t count = 1) {
+            this->allocator_->invalidate(*this->buffer_info, Offsets[index], Offsets[index + count] - Offsets[index]);
+        }
+
+        /**
+         * @brief Mark {count} objects from {index} as dirty, they're invalidated by flush()
+         *
+         * @param index Index
+         * @param count Count
+         */
+        void markDirty(size_t index, size_t count = 1) {
+            Buffer::markDirty(Offsets[index], Offsets[index + count] - Offsets[index]);
+        }
+    };
+
+    namespace {
+        /**
+         * @brief Get element at index {Index}
+         *
+         * @tparam Index Index
+         * @tparam Alignment Alignment of elements
+         * @tparam T Tuple's types
+         * @param tuple Tuple
+         * @return std::tuple_element<Index, std::tuple<T...>>::type& Value
+         */
+        template<size_t Index, size_t Alignment, class... T>
+        inline typename std::tuple_element<Index, std::tuple<T...>>::type& get(AlignedTuple<Alignment, T...>& tuple) {
+            constexpr vk::DeviceSize offset = AlignedTuple<Alignment, T...>::Offsets[Index];
+
+            return *reinterpret_cast<typename std::tuple_element<Index, std::tuple<T...>>::type*>(static_cast<char*>(*tuple.info().ptr) + offset);
+        }
+    }  // namespace
+}  // namespace ao::vulkan
@@ -0,0 +1,199 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include "allocator.h"
+
+#include <cstring>
+#include <fstream>
+
+#include <ao/core/exception/exception.h>
+#include <ao/core/logging/log.h>
+#include <fmt/format.h>
+
+namespace {
+    /**
+     * @brief Get histogram's bucket of an allocation: floor(log2(size)), clamped to histogram
+     *
+     * @param size Allocation's size
+     * @return size_t Bucket
+     */
+    inline size_t histogramBucket(vk::DeviceSize size) {
+        size_t bucket = 0;
+
+        while (bucket + 1 < ao::vulkan::Allocator::Statistics::HistogramSize && (size >> (bucket + 1)) > 0) {
+            bucket++;
+        }
+        return bucket;
+    }
+}  // namespace
+
+ao::vulkan::Allocator::Allocator(std::shared_ptr<ao::vulkan::Device> device)
+    : allocated(0), allocation_count(0), over_budget_heaps(0), device(device) {
+    for (auto& usage : this->heap_usages) {
+        usage = 0;
+    }
+    for (size_t i = 0; i < VK_MAX_MEMORY_TYPES; i++) {
+        this->type_usages[i] = 0;
+        this->type_blocks[i] = 0;
+    }
+    for (auto& count : this->histogram) {
+        count = 0;
+    }
+}
+
+void ao::vulkan::Allocator::copy(BufferInfo const& source, BufferInfo const& destination, vk::DeviceSize size) {
+    // Check pointers
+    if (!source.ptr || !destination.ptr) {
+        throw ao::core::Exception("Fail to copy buffer, memory isn't mapped");
+    }
+
+    std::memcpy(*destination.ptr, *source.ptr, size);
+    this->invalidate(destination, 0, size);
+}
+
+void ao::vulkan::Allocator::invalidateRanges(BufferInfo const& info, std::map<vk::DeviceSize, vk::DeviceSize> const& ranges) {
+    for (auto& [begin, end] : ranges) {
+        this->invalidate(info, begin, end - begin);
+    }
+}
+
+ao::vulkan::Allocator::HeapBudget ao::vulkan::Allocator::budget(u32 heap) const {
+    // Query budget
+    if (this->device->extensionEnabled(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)) {
+        auto properties =
+            this->device->physical().getMemoryProperties2<vk::PhysicalDeviceMemoryProperties2, vk::PhysicalDeviceMemoryBudgetPropertiesEXT>();
+        auto& budget = properties.get<vk::PhysicalDeviceMemoryBudgetPropertiesEXT>();
+
+        return {budget.heapUsage[heap], budget.heapBudget[heap]};
+    }
+
+    return {this->heap_usages.at(heap), this->device->memoryProperties().memoryHeaps[heap].size * 8 / 10};
+}
+
+ao::vulkan::Allocator::Statistics ao::vulkan::Allocator::statistics() const {
+    ao::vulkan::Allocator::Statistics statistics;
+
+    // Memory types
+    for (u32 i = 0; i < this->device->memoryProperties().memoryTypeCount; i++) {
+        if (this->type_blocks[i] > 0) {
+            auto& type = statistics.memory_types[i];
+
+            type.blocks = this->type_blocks[i];
+            type.memory = this->type_usages[i];
+        }
+    }
+
+    // Allocations
+    for (size_t i = 0; i < statistics.histogram.size(); i++) {
+        statistics.histogram[i] = this->histogram[i];
+    }
+    statistics.allocated = this->allocated;
+    statistics.allocations = this->allocation_count;
+
+    return statistics;
+}
+
+std::string ao::vulkan::Allocator::dump() const {
+    auto statistics = this->statistics();
+    auto& properties = this->device->memoryProperties();
+    std::string json = fmt::format("{{\"allocations\": {}, \"allocated\": {}, \"host_copies\": {}, \"histogram\": [", statistics.allocations,
+                                   statistics.allocated, statistics.host_copies);
+
+    // Histogram (empty buckets are skipped)
+    std::string separator;
+    for (size_t i = 0; i < statistics.histogram.size(); i++) {
+        if (statistics.histogram[i] > 0) {
+            json += fmt::format("{}{{\"size\": {}, \"count\": {}}}", separator, u64(1) << i, statistics.histogram[i]);
+            separator = ", ";
+        }
+    }
+
+    // Memory types
+    json += "], \"memory_types\": [";
+    separator.clear();
+    for (auto& [index, type] : statistics.memory_types) {
+        json += fmt::format(
+            "{}{{\"index\": {}, \"heap\": {}, \"flags\": \"{}\", \"blocks\": {}, \"memory\": {}, \"used\": {}, \"free\": {}, "
+            "\"largest_free\": {}}}",
+            separator, index, properties.memoryTypes[index].heapIndex, vk::to_string(properties.memoryTypes[index].propertyFlags), type.blocks,
+            type.memory, type.used(), type.free, type.largest_free);
+        separator = ", ";
+    }
+
+    // Heaps
+    json += "], \"heaps\": [";
+    separator.clear();
+    for (u32 i = 0; i < properties.memoryHeapCount; i++) {
+        auto budget = this->budget(i);
+
+        json += fmt::format("{}{{\"index\": {}, \"size\": {}, \"allocator_usage\": {}, \"usage\": {}, \"budget\": {}}}", separator, i,
+                            properties.memoryHeaps[i].size, this->heap_usages[i].load(), budget.usage, budget.budget);
+        separator = ", ";
+    }
+    return json + "]}";
+}
+
+void ao::vulkan::Allocator::track(u32 memory_type, vk::DeviceSize size) {
+    u32 heap = this->device->memoryProperties().memoryTypes[memory_type].heapIndex;
+
+    this->heap_usages.at(heap) += size;
+    this->type_usages.at(memory_type) += size;
+    this->type_blocks.at(memory_type)++;
+
+    // Check budget (callback is called by notifyOverBudget(), as pool's lock may be held here)
+    if (this->over_budget) {
+        auto budget = this->budget(heap);
+
+        if (budget.usage > budget.budget) {
+            this->over_budget_heaps.fetch_or(1u << heap, std::memory_order_acq_rel);
+        }
+    }
+}
+
+void ao::vulkan::Allocator::untrack(u32 memory_type, vk::DeviceSize size) {
+    this->heap_usages.at(this->device->memoryProperties().memoryTypes[memory_type].heapIndex) -= size;
+    this->type_usages.at(memory_type) -= size;
+    this->type_blocks.at(memory_type)--;
+}
+
+void ao::vulkan::Allocator::trackAllocation(vk::DeviceSize size) {
+    this->histogram[histogramBucket(size)]++;
+    this->allocated += size;
+    this->allocation_count++;
+}
+
+void ao::vulkan::Allocator::untrackAllocation(vk::DeviceSize size) {
+    this->histogram[histogramBucket(size)]--;
+    this->allocated -= size;
+    this->allocation_count--;
+}
+
+void ao::vulkan::Allocator::notifyOverBudget() {
+    u32 heaps = this->over_budget_heaps.exchange(0, std::memory_order_acq_rel);
+
+    for (u32 heap = 0; heaps != 0; heap++, heaps >>= 1) {
+        if ((heaps & 1) == 0) {
+            continue;
+        }
+
+        // Heap may be under budget again
+        auto budget = this->budget(heap);
+        if (this->over_budget && budget.usage > budget.budget) {
+            this->over_budget(heap, budget);
+        }
+    }
+}
+
+void ao::vulkan::Allocator::allocationFailed(vk::SystemError const& error) const {
+    // Check error
+    if (!this->out_of_memory_dump ||
+        (error.code() != vk::Result::eErrorOutOfDeviceMemory && error.code() != vk::Result::eErrorOutOfHostMemory)) {
+        return;
+    }
+
+    // Write dump
+    std::ofstream file(*this->out_of_memory_dump);
+    file << this->dump();
+    LOG_MSG(error) << fmt::format("Out of memory: {}, memory dump is written in {}", error.what(), *this->out_of_memory_dump);
+}
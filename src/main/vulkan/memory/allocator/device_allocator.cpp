@@ -4,16 +4,52 @@
 
 #include "device_allocator.h"
 
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <tuple>
+
+#include <ao/core/exception/exception.h>
 #include <ao/core/utilities/memory.h>
+#include <fmt/format.h>
 
 #include "../../exception/unknown_allocation.h"
-#include "../../utilities/device.h"
 
-ao::vulkan::DeviceAllocator::DeviceAllocator(std::shared_ptr<Device> device, vk::CommandBufferUsageFlags cmd_usage, size_t alignment)
-    : ao::vulkan::Allocator(device), cmd_usage(cmd_usage), alignment(alignment) {}
+ao::vulkan::DeviceAllocator::DeviceAllocator(std::shared_ptr<Device> device, vk::CommandBufferUsageFlags cmd_usage, size_t alignment,
+                                             ao::vulkan::DeviceAllocationStrategy strategy, vk::DeviceSize block_size,
+                                             std::shared_ptr<ao::vulkan::StagingRing> staging_ring)
+    : ao::vulkan::Allocator(device),
+      host_size(0),
+      device_size(0),
+      staging_ring(device->unifiedMemory() ? nullptr : staging_ring),
+      transfer_mode(ao::vulkan::TransferMode::eImmediate),
+      cmd_usage(cmd_usage),
+      alignment(alignment),
+      strategy(strategy),
+      unified_memory(device->unifiedMemory()) {
+    if (strategy == ao::vulkan::DeviceAllocationStrategy::eTLSF || this->unified_memory) {
+        // Unified memory is mapped by its blocks (eDedicated strategy gets a dedicated block per allocation)
+        auto memory_flags = this->unified_memory ? vk::MemoryPropertyFlagBits::eDeviceLocal | vk::MemoryPropertyFlagBits::eHostVisible
+                                                 : vk::MemoryPropertyFlags(vk::MemoryPropertyFlagBits::eDeviceLocal);
+        this->pool = std::make_unique<ao::vulkan::MemoryPool>(device, memory_flags, block_size, ao::vulkan::SubAllocatorType::eTLSF);
+        if (strategy == ao::vulkan::DeviceAllocationStrategy::eDedicated) {
+            this->pool->setDedicatedThreshold(0);
+        }
+
+        // Track blocks
+        this->pool->setAfterBlockCreation([this](ao::vulkan::MemoryBlock const& block) { this->track(block.memoryType(), block.memorySize()); });
+        this->pool->setBeforeBlockDestruction(
+            [this](ao::vulkan::MemoryBlock const& block) { this->untrack(block.memoryType(), block.memorySize()); });
+    }
+}
 
 ao::vulkan::DeviceAllocator::~DeviceAllocator() {
-    for (auto& [key, allocation] : this->allocations) {
+    // Wait transfers
+    for (auto& batch : this->batches) {
+        batch.fence.wait();
+    }
+
+    this->allocations.forEach([this]([[maybe_unused]] u64 handle, ao::vulkan::DeviceAllocator::Allocation& allocation) {
         // Host
         if (allocation.host.first.buffer != vk::Buffer()) {
             this->device->logical()->unmapMemory(allocation.host.second);
@@ -21,174 +57,679 @@ ao::vulkan::DeviceAllocator::~DeviceAllocator() {
             this->device->logical()->freeMemory(allocation.host.second);
         }
 
-        // Device
-        this->device->logical()->destroyBuffer(allocation.device.first.buffer);
-        this->device->logical()->freeMemory(allocation.device.second);
-
-        // Others
-        if (allocation.host.first.buffer != vk::Buffer()) {
-            this->device->transferPool().freeCommandBuffers(allocation.command);
-            allocation.fence.destroy();
+        // Device (sub-allocated ranges are released with their pool)
+        if (!allocation.block) {
+            this->device->logical()->destroyBuffer(allocation.device.first.buffer);
+            this->device->logical()->freeMemory(allocation.device.second);
         }
+    });
+
+    // Batches
+    for (auto& batch : this->batches) {
+        this->device->transferPool().freeCommandBuffers(batch.command);
+        batch.fence.destroy();
     }
 }
 
 void ao::vulkan::DeviceAllocator::invalidate(BufferInfo const& info, vk::DeviceSize const& offset, vk::DeviceSize const& size) {
     // Check info
-    if (!this->own(info)) {
+    auto allocation = this->allocations.get(info.handle);
+    if (!allocation) {
         throw ao::vulkan::UnknownAllocation();
     }
 
-    auto& allocation = this->allocations[info.buffer];
+    // Nothing to transfer
+    if (size == 0) {
+        return;
+    }
+    this->checkRange(*allocation, offset + size);
 
-    // Create command to transfer data from host to device
-    allocation.command.begin(vk::CommandBufferBeginInfo(this->cmd_usage));
-    allocation.command.copyBuffer(allocation.host.first.buffer, allocation.device.first.buffer, vk::BufferCopy(offset, offset, size));
-    allocation.command.end();
+    // Unified memory is written directly
+    if (this->unified_memory) {
+        this->invalidateRanges(info, {{offset, offset + size}});
+        return;
+    }
 
-    // Reset fence
-    allocation.fence.reset();
+    std::unique_lock lock(this->transfer_mutex);
 
-    // Submit command
-    this->device->queues()->submit(vk::QueueFlagBits::eTransfer, vk::SubmitInfo().setCommandBufferCount(1).setPCommandBuffers(&allocation.command),
-                                   allocation.fence);
+    // Add range to pending ones, merge it with overlapping or adjacent ranges
+    ao::core::utilities::mergeRange(this->pending[info.handle], offset, offset + size);
 
-    // Wait fence
-    allocation.fence.wait();
+    // Transfer now
+    if (this->transfer_mode == ao::vulkan::TransferMode::eImmediate) {
+        auto fence = this->submitPending(vk::Semaphore());
+        lock.unlock();
+
+        // Wait fence
+        fence.wait();
+    }
+}
+
+void ao::vulkan::DeviceAllocator::invalidateRanges(ao::vulkan::Allocator::BufferInfo const& info,
+                                                   std::map<vk::DeviceSize, vk::DeviceSize> const& ranges) {
+    // Check info
+    auto allocation = this->allocations.get(info.handle);
+    if (!allocation) {
+        throw ao::vulkan::UnknownAllocation();
+    }
+
+    // Nothing to transfer
+    if (ranges.empty()) {
+        return;
+    }
+    for (auto& [begin, end] : ranges) {
+        this->checkRange(*allocation, end);
+    }
+
+    // Unified memory is written directly, it's only flushed if it isn't coherent
+    if (this->unified_memory) {
+        if (!allocation->block->coherent()) {
+            std::vector<vk::MappedMemoryRange> memory_ranges;
+            for (auto& [begin, end] : ranges) {
+                memory_ranges.push_back(allocation->block->flushRange(allocation->device.first.offset + begin, end - begin));
+            }
+            this->device->logical()->flushMappedMemoryRanges(memory_ranges);
+        }
+        return;
+    }
+
+    std::unique_lock lock(this->transfer_mutex);
+
+    // Add ranges to pending ones
+    auto& pending_ranges = this->pending[info.handle];
+    for (auto& [begin, end] : ranges) {
+        ao::core::utilities::mergeRange(pending_ranges, begin, end);
+    }
+
+    // Transfer now, in a single submission
+    if (this->transfer_mode == ao::vulkan::TransferMode::eImmediate) {
+        auto fence = this->submitPending(vk::Semaphore());
+        lock.unlock();
+
+        // Wait fence
+        fence.wait();
+    }
 }
 
 ao::vulkan::Allocator::BufferInfo ao::vulkan::DeviceAllocator::allocate(vk::DeviceSize size, vk::BufferUsageFlags usage) {
     ao::vulkan::DeviceAllocator::Allocation allocation;
     ao::vulkan::Allocator::BufferInfo info;
 
-    // Host buffer
+    try {
+        // Host buffer (unified memory is mapped, so it doesn't need one)
+        if (this->staging_ring) {
+            // Keep a copy on host, it's transferred through staging ring
+            allocation.shadow.resize(size);
+            info.ptr = allocation.shadow.data();
+            info.size = size;
+
+            // Fill allocation (copy is counted in host size, but isn't tracked in memory types as it isn't Vulkan memory)
+            allocation.host = std::make_pair(ao::vulkan::Allocator::BufferInfo(size, vk::Buffer(), info.ptr), vk::DeviceMemory());
+        } else if (!this->unified_memory) {
+            // Create buffer (allocation is filled as resources are created, so that they're released on failure)
+            auto& host = allocation.host;
+            host.first.buffer = this->device->logical()->createBuffer(
+                vk::BufferCreateInfo(vk::BufferCreateFlags(), size, vk::BufferUsageFlagBits::eTransferSrc | usage, vk::SharingMode::eExclusive));
+
+            // Get memory requirements
+            auto mem_requirements = this->device->logical()->getBufferMemoryRequirements(host.first.buffer);
+
+            // Allocate memory
+            allocation.host_memory_type = this->device->memoryType(
+                mem_requirements.memoryTypeBits, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+            auto dedicated_info = vk::MemoryDedicatedAllocateInfo(vk::Image(), host.first.buffer);
+            host.second = this->device->logical()->allocateMemory(
+                vk::MemoryAllocateInfo(mem_requirements.size, allocation.host_memory_type).setPNext(&dedicated_info));
+            host.first.size = mem_requirements.size;
+            this->track(allocation.host_memory_type, mem_requirements.size);
+
+            // Bind memory and buffer
+            this->device->logical()->bindBufferMemory(host.first.buffer, host.second, 0);
+
+            // Map memory
+            host.first.ptr = this->device->logical()->mapMemory(host.second, 0, mem_requirements.size);
+
+            // Set pointer (host buffer may be bigger than device range, so size is the requested one)
+            info.ptr = host.first.ptr;
+            info.size = size;
+        }
+
+        // Device buffer (source of copies when it's moved by defragmentation or copied by copy())
+        auto device_usage = vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst | usage;
+        if (this->pool) {
+            std::lock_guard lock(this->pool_mutex);
+
+            // Allocate range (ranges moved by defragmentation are released first, so that they can be reused)
+            this->releaseRetiredRanges();
+            auto range = this->pool->allocate(size, device_usage);
+            info.buffer = range.block->buffer();
+            info.offset = range.offset;
+
+            // Fill allocation
+            allocation.device =
+                std::make_pair(ao::vulkan::Allocator::BufferInfo(range.size, info.buffer, std::nullopt, range.offset), range.block->memory());
+            allocation.block = range.block;
+
+            // Write unified memory directly
+            if (this->unified_memory) {
+                info.ptr = range.block->ptr(range.offset);
+                info.size = size;
+                info.coherent = range.block->coherent();
+            }
+        } else {
+            // Create buffer
+            auto& dedicated = allocation.device;
+            dedicated.first.buffer = this->device->logical()->createBuffer(
+                vk::BufferCreateInfo(vk::BufferCreateFlags(), size, device_usage, vk::SharingMode::eExclusive));
+
+            // Get memory requirements
+            auto mem_requirements = this->device->logical()->getBufferMemoryRequirements(dedicated.first.buffer);
+
+            // Allocate memory
+            allocation.device_memory_type = this->device->memoryType(mem_requirements.memoryTypeBits, vk::MemoryPropertyFlagBits::eDeviceLocal);
+            auto dedicated_info = vk::MemoryDedicatedAllocateInfo(vk::Image(), dedicated.first.buffer);
+            dedicated.second = this->device->logical()->allocateMemory(
+                vk::MemoryAllocateInfo(mem_requirements.size, allocation.device_memory_type).setPNext(&dedicated_info));
+            dedicated.first.size = mem_requirements.size;
+            this->track(allocation.device_memory_type, mem_requirements.size);
+
+            // Bind memory and buffer
+            this->device->logical()->bindBufferMemory(dedicated.first.buffer, dedicated.second, 0);
+            info.buffer = dedicated.first.buffer;
+        }
+    } catch (vk::SystemError const& error) {
+        this->release(allocation);
+        this->allocationFailed(error);
+        throw;
+    } catch (...) {
+        this->release(allocation);
+        throw;
+    }
+
+    // Add to allocations
+    allocation.size = size;
+    this->host_size += allocation.host.first.size;
+    this->device_size += allocation.device.first.size;
+    this->trackAllocation(info.size);
+    info.handle = this->allocations.insert(std::move(allocation));
+
+    // Evict resources if new memory exceeds budget
+    this->notifyOverBudget();
+    return info;
+}
+
+void ao::vulkan::DeviceAllocator::free(Allocator::BufferInfo const& info) {
+    std::optional<ao::vulkan::DeviceAllocator::Allocation> allocation;
+    std::vector<ao::vulkan::Fence> fences;
+
     {
-        // Create buffer
-        auto buffer = this->device->logical()->createBuffer(
-            vk::BufferCreateInfo(vk::BufferCreateFlags(), size, vk::BufferUsageFlagBits::eTransferSrc | usage, vk::SharingMode::eExclusive));
+        std::lock_guard transfer_lock(this->transfer_mutex);
+        std::lock_guard lock(this->pool_mutex);
 
-        // Get memory requirements
-        auto mem_requirements = this->device->logical()->getBufferMemoryRequirements(buffer);
+        // Remove from allocations (under pool's lock, as defragmentation walks through allocations), a concurrent free fails
+        allocation = this->allocations.extract(info.handle);
+        if (!allocation) {
+            throw ao::vulkan::UnknownAllocation();
+        }
 
-        // Allocate memory
-        auto memory = this->device->logical()->allocateMemory(vk::MemoryAllocateInfo(
-            mem_requirements.size,
-            ao::vulkan::utilities::memoryType(this->device->physical(), mem_requirements.memoryTypeBits,
-                                              vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)));
+        // Drop pending ranges
+        this->pending.erase(info.handle);
+        fences = this->batchFences(info.handle);
+        if (this->pool) {
+            this->releaseRetiredRanges();
+        }
+    }
+
+    // Wait transfers using buffers
+    for (auto& fence : fences) {
+        fence.wait();
+    }
 
-        // Bind memory and buffer
-        this->device->logical()->bindBufferMemory(buffer, memory, 0);
+    // Free
+    this->release(*allocation);
+    this->host_size -= allocation->host.first.size;
+    this->device_size -= allocation->device.first.size;
+    this->untrackAllocation(info.size);
+}
+
+void ao::vulkan::DeviceAllocator::release(ao::vulkan::DeviceAllocator::Allocation& allocation) {
+    // Host
+    if (allocation.host.second) {
+        if (allocation.host.first.ptr) {
+            this->device->logical()->unmapMemory(allocation.host.second);
+        }
+        this->device->logical()->freeMemory(allocation.host.second);
+        this->untrack(allocation.host_memory_type, allocation.host.first.size);
+    }
+    if (allocation.host.first.buffer) {
+        this->device->logical()->destroyBuffer(allocation.host.first.buffer);
+    }
+
+    // Device
+    if (allocation.block) {
+        std::lock_guard lock(this->pool_mutex);
+        this->pool->free({allocation.block, allocation.device.first.offset, allocation.device.first.size});
+        return;
+    }
+    if (allocation.device.second) {
+        this->device->logical()->freeMemory(allocation.device.second);
+        this->untrack(allocation.device_memory_type, allocation.device.first.size);
+    }
+    if (allocation.device.first.buffer) {
+        this->device->logical()->destroyBuffer(allocation.device.first.buffer);
+    }
+}
 
-        // Map memory
-        info.ptr = this->device->logical()->mapMemory(memory, 0, mem_requirements.size);
+void ao::vulkan::DeviceAllocator::copy(ao::vulkan::Allocator::BufferInfo const& source, ao::vulkan::Allocator::BufferInfo const& destination,
+                                       vk::DeviceSize size) {
+    // Check infos
+    auto from = this->allocations.get(source.handle);
+    auto to = this->allocations.get(destination.handle);
+    if (!from || !to) {
+        throw ao::vulkan::UnknownAllocation();
+    }
 
-        // Set size
-        info.size = mem_requirements.size;
+    // Nothing to copy
+    if (size == 0) {
+        return;
+    }
+    this->checkRange(*from, size);
+    this->checkRange(*to, size);
+
+    // Copy host copies (through allocations, as caller's pointers are stale once host copy is freed or buffer is reallocated)
+    auto source_ptr = this->hostPtr(*from);
+    auto destination_ptr = this->hostPtr(*to);
+    if (source_ptr && destination_ptr && *source_ptr && *destination_ptr) {
+        std::memcpy(*destination_ptr, *source_ptr, size);
+    }
 
-        // Fill allocation
-        allocation.host = std::make_pair(ao::vulkan::Allocator::BufferInfo(info.size, buffer, info.ptr), memory);
+    // Unified memory is copied on host
+    if (this->unified_memory) {
+        this->invalidateRanges(destination, {{0, size}});
+        return;
     }
 
-    // Device buffer
+    ao::vulkan::Fence fence;
     {
-        // Create buffer
-        info.buffer = this->device->logical()->createBuffer(
-            vk::BufferCreateInfo(vk::BufferCreateFlags(), size, vk::BufferUsageFlagBits::eTransferDst | usage, vk::SharingMode::eExclusive));
+        std::lock_guard lock(this->transfer_mutex);
 
-        // Get memory requirements
-        auto mem_requirements = this->device->logical()->getBufferMemoryRequirements(info.buffer);
+        // Transfer data that isn't on device yet
+        if (this->pending.count(source.handle) != 0) {
+            this->submitPending(vk::Semaphore()).wait();
+        }
 
-        // Allocate memory
-        auto memory = this->device->logical()->allocateMemory(vk::MemoryAllocateInfo(
-            mem_requirements.size,
-            ao::vulkan::utilities::memoryType(this->device->physical(), mem_requirements.memoryTypeBits, vk::MemoryPropertyFlagBits::eDeviceLocal)));
+        // Copy on device
+        auto& batch = this->acquireBatch();
+        batch.command.begin(vk::CommandBufferBeginInfo(this->cmd_usage));
+        batch.command.copyBuffer(from->device.first.buffer, to->device.first.buffer,
+                                 vk::BufferCopy(from->device.first.offset, to->device.first.offset, size));
+        batch.handles = {source.handle, destination.handle};
+        this->submitBatch(batch, vk::Semaphore());
+        fence = batch.fence;
+    }
 
-        // Bind memory and buffer
-        this->device->logical()->bindBufferMemory(info.buffer, memory, 0);
+    // Wait fence
+    fence.wait();
+}
+
+ao::vulkan::Allocator::Statistics ao::vulkan::DeviceAllocator::statistics() const {
+    auto statistics = ao::vulkan::Allocator::statistics();
 
-        // Fill allocation
-        allocation.device = std::make_pair(ao::vulkan::Allocator::BufferInfo(mem_requirements.size, info.buffer), memory);
+    // Add free space of blocks
+    if (this->pool) {
+        std::lock_guard lock(this->pool_mutex);
+        this->pool->statistics(statistics.memory_types);
     }
 
-    // Create command buffer
-    allocation.command = this->device->transferPool().allocateCommandBuffers(vk::CommandBufferLevel::ePrimary, 1).front();
+    // With a staging ring, host memory is made of host copies
+    if (this->staging_ring) {
+        statistics.host_copies = this->host_size;
+    }
+    return statistics;
+}
 
-    // Create fence
-    allocation.fence = ao::vulkan::Fence(this->device->logical());
+size_t ao::vulkan::DeviceAllocator::alignSize(size_t size) const {
+    return ao::core::utilities::calculateAligmentSize(size, this->alignment);
+}
 
-    // Add to allocations
-    this->allocations_mutex.lock();
-    this->allocations[info.buffer] = allocation;
-    this->allocations_mutex.unlock();
+void ao::vulkan::DeviceAllocator::setRelocationCallback(ao::vulkan::Allocator::BufferInfo const& info,
+                                                        std::function<void(vk::Buffer, vk::DeviceSize)> callback) {
+    // Check info
+    auto allocation = this->allocations.get(info.handle);
+    if (!allocation) {
+        throw ao::vulkan::UnknownAllocation();
+    }
 
-    return info;
+    std::lock_guard lock(this->pool_mutex);
+    allocation->relocation = callback;
 }
 
-void ao::vulkan::DeviceAllocator::free(Allocator::BufferInfo const& info) {
+bool ao::vulkan::DeviceAllocator::own(ao::vulkan::Allocator::BufferInfo const& info) const {
+    return this->allocations.contains(info.handle);
+}
+
+void ao::vulkan::DeviceAllocator::freeHost(ao::vulkan::Allocator::BufferInfo const& info) {
     // Check info
-    if (!this->own(info)) {
+    auto allocation = this->allocations.get(info.handle);
+    if (!allocation) {
         throw ao::vulkan::UnknownAllocation();
     }
 
+    // Unified memory has no host buffer
+    if (this->unified_memory) {
+        return;
+    }
+
+    // Transfer pending ranges & wait transfers using host buffer
+    std::vector<ao::vulkan::Fence> fences;
+    {
+        std::lock_guard lock(this->transfer_mutex);
+
+        if (this->pending.count(info.handle) != 0) {
+            this->submitPending(vk::Semaphore());
+        }
+        fences = this->batchFences(info.handle);
+    }
+    for (auto& fence : fences) {
+        fence.wait();
+    }
+
     // Free
-    auto& allocation = this->allocations[info.buffer];
-    if (allocation.host.first.buffer != vk::Buffer()) {  // Host
-        this->device->logical()->unmapMemory(allocation.host.second);
-        this->device->logical()->destroyBuffer(allocation.host.first.buffer);
-        this->device->logical()->freeMemory(allocation.host.second);
+    if (this->staging_ring) {  // Host copy
+        allocation->shadow = std::vector<char>();
+        this->host_size -= allocation->host.first.size;
+
+        // Indicate that host copy is destroyed
+        allocation->host.first.ptr = nullptr;
+        allocation->host.first.size = 0;
+        return;
     }
-    this->device->logical()->destroyBuffer(allocation.device.first.buffer);  // Device
-    this->device->logical()->freeMemory(allocation.device.second);
-    if (allocation.host.first.buffer != vk::Buffer()) {  // Others
-        this->device->transferPool().freeCommandBuffers(allocation.command);
-        allocation.fence.destroy();
+    this->device->logical()->unmapMemory(allocation->host.second);  // Host
+    this->device->logical()->destroyBuffer(allocation->host.first.buffer);
+    this->device->logical()->freeMemory(allocation->host.second);
+    this->untrack(allocation->host_memory_type, allocation->host.first.size);
+    this->host_size -= allocation->host.first.size;
+
+    // Indicate that host buffer is destroyed
+    allocation->host.second = vk::DeviceMemory();
+    allocation->host.first.buffer = vk::Buffer();
+    allocation->host.first.ptr = nullptr;
+    allocation->host.first.size = 0;
+}
+
+void ao::vulkan::DeviceAllocator::setTransferMode(ao::vulkan::TransferMode mode) {
+    std::unique_lock lock(this->transfer_mutex);
+
+    // Flush pending ranges
+    if (mode == ao::vulkan::TransferMode::eImmediate && this->transfer_mode == ao::vulkan::TransferMode::eDeferred) {
+        auto fence = this->submitPending(vk::Semaphore());
+
+        // Wait fence
+        if (fence) {
+            fence.wait();
+        }
     }
+    this->transfer_mode = mode;
+}
+
+ao::vulkan::Fence ao::vulkan::DeviceAllocator::flush(vk::Semaphore signal) {
+    std::lock_guard lock(this->transfer_mutex);
 
-    // Remove from allocations
-    this->allocations_mutex.lock();
-    this->allocations.erase(info.buffer);
-    this->allocations_mutex.unlock();
+    // Release ranges whose data is moved
+    if (this->pool) {
+        std::lock_guard pool_lock(this->pool_mutex);
+        this->releaseRetiredRanges();
+    }
+    return this->submitPending(signal);
 }
 
-size_t ao::vulkan::DeviceAllocator::alignSize(size_t size) const {
-    return ao::core::utilities::calculateAligmentSize(size, this->alignment);
+ao::vulkan::Fence ao::vulkan::DeviceAllocator::defragment(vk::DeviceSize max_bytes, vk::Semaphore signal) {
+    std::vector<std::pair<std::function<void(vk::Buffer, vk::DeviceSize)>, std::pair<vk::Buffer, vk::DeviceSize>>> relocations;
+    ao::vulkan::Fence fence;
+
+    // Check strategy (unified memory isn't moved, as its pointers would be invalidated)
+    if (!this->pool || this->unified_memory) {
+        return fence;
+    }
+
+    {
+        std::lock_guard transfer_lock(this->transfer_mutex);
+        std::lock_guard lock(this->pool_mutex);
+
+        // Release ranges whose data is moved
+        this->releaseRetiredRanges();
+
+        // Find block to empty
+        auto source = this->pool->defragmentationCandidate();
+        if (!source) {
+            return fence;
+        }
+
+        // Wait transfers writing into allocations
+        for (auto& batch : this->batches) {
+            batch.fence.wait();
+        }
+
+        // Find new ranges
+        std::vector<std::tuple<ao::vulkan::DeviceAllocator::Allocation*, ao::vulkan::MemoryPool::Range, ao::vulkan::MemoryPool::Range>> moves;
+        std::vector<u64> handles;
+        vk::DeviceSize moved = 0;
+        bool done = false;
+        this->allocations.forEach([&](u64 handle, ao::vulkan::DeviceAllocator::Allocation& allocation) {
+            if (done || allocation.block != source || this->pending.count(handle) != 0) {
+                return;
+            }
+            if (moved > 0 && moved + allocation.device.first.size > max_bytes) {
+                done = true;
+                return;
+            }
+
+            auto range = this->pool->fit(allocation.device.first.size, source->usage(), source);
+            if (!range) {
+                done = true;
+                return;
+            }
+
+            auto from = ao::vulkan::MemoryPool::Range{source, allocation.device.first.offset, allocation.device.first.size};
+            moves.push_back(std::make_tuple(&allocation, from, *range));
+            handles.push_back(handle);
+            moved += allocation.device.first.size;
+        });
+        if (moves.empty()) {
+            return fence;
+        }
+
+        // Record copies
+        auto& batch = this->acquireBatch();
+        batch.command.begin(vk::CommandBufferBeginInfo(this->cmd_usage));
+        for (auto& [allocation, from, to] : moves) {
+            batch.command.copyBuffer(from.block->buffer(), to.block->buffer(), vk::BufferCopy(from.offset, to.offset, from.size));
+        }
+        batch.handles = std::move(handles);
+        this->submitBatch(batch, signal);
+        fence = batch.fence;
+
+        // Update allocations (handles don't change, later transfers wait batch through them)
+        for (auto& [allocation, from, to] : moves) {
+            this->device_size += to.size;
+            this->device_size -= from.size;
+            allocation->device =
+                std::make_pair(ao::vulkan::Allocator::BufferInfo(to.size, to.block->buffer(), std::nullopt, to.offset), to.block->memory());
+            allocation->block = to.block;
+
+            relocations.push_back(std::make_pair(allocation->relocation, std::make_pair(to.block->buffer(), to.offset)));
+
+            // Old range is released once copy is over (by the next allocation, free, flush or defragmentation)
+            this->retired_ranges.push_back(std::make_pair(fence, from));
+        }
+    }
+
+    // Tell owners
+    for (auto& [callback, key] : relocations) {
+        if (callback) {
+            callback(key.first, key.second);
+        }
+    }
+    return fence;
 }
 
-vk::DeviceSize ao::vulkan::DeviceAllocator::size() const {
-    return std::accumulate(this->allocations.begin(), this->allocations.end(), vk::DeviceSize(0),
-                           [](vk::DeviceSize result, auto pair) { return result + pair.second.host.first.size + pair.second.device.first.size; });
+void ao::vulkan::DeviceAllocator::checkRange(ao::vulkan::DeviceAllocator::Allocation const& allocation, vk::DeviceSize end) const {
+    if (end > allocation.size) {
+        throw ao::core::Exception(fmt::format("Range's end {} is out of allocation of {} bytes", end, allocation.size));
+    }
 }
 
-vk::DeviceSize ao::vulkan::DeviceAllocator::sizeOnDevice() const {
-    return std::accumulate(this->allocations.begin(), this->allocations.end(), vk::DeviceSize(0),
-                           [](vk::DeviceSize result, auto pair) { return result + pair.second.device.first.size; });
+std::optional<void*> ao::vulkan::DeviceAllocator::hostPtr(ao::vulkan::DeviceAllocator::Allocation const& allocation) const {
+    if (this->unified_memory) {
+        return allocation.block->ptr(allocation.device.first.offset);
+    }
+    return allocation.host.first.ptr;
 }
 
-vk::DeviceSize ao::vulkan::DeviceAllocator::sizeOnHost() const {
-    return std::accumulate(this->allocations.begin(), this->allocations.end(), vk::DeviceSize(0),
-                           [](vk::DeviceSize result, auto pair) { return result + pair.second.host.first.size; });
+void ao::vulkan::DeviceAllocator::releaseRetiredRanges() {
+    this->retired_ranges.erase(std::remove_if(this->retired_ranges.begin(), this->retired_ranges.end(),
+                                              [pool = this->pool.get()](auto& pair) {
+                                                  if (pair.first.status() != ao::vulkan::FenceStatus::eSignaled) {
+                                                      return false;
+                                                  }
+                                                  pool->free(pair.second);
+                                                  return true;
+                                              }),
+                               this->retired_ranges.end());
 }
 
-bool ao::vulkan::DeviceAllocator::own(ao::vulkan::Allocator::BufferInfo const& info) const {
-    return this->allocations.count(info.buffer) != 0;
+std::vector<ao::vulkan::Fence> ao::vulkan::DeviceAllocator::batchFences(u64 handle) const {
+    std::vector<ao::vulkan::Fence> fences;
+
+    for (auto& batch : this->batches) {
+        if (std::find(batch.handles.begin(), batch.handles.end(), handle) != batch.handles.end()) {
+            fences.push_back(batch.fence);
+        }
+    }
+    return fences;
 }
 
-void ao::vulkan::DeviceAllocator::freeHost(ao::vulkan::Allocator::BufferInfo const& info) {
-    // Check info
-    if (!this->own(info)) {
-        throw ao::vulkan::UnknownAllocation();
+ao::vulkan::DeviceAllocator::Batch& ao::vulkan::DeviceAllocator::acquireBatch() {
+    // Find a batch whose transfer is over
+    for (auto& batch : this->batches) {
+        if (batch.fence.status() == ao::vulkan::FenceStatus::eSignaled) {
+            batch.handles.clear();
+            return batch;
+        }
     }
 
-    // Free
-    auto& allocation = this->allocations[info.buffer];
-    this->device->logical()->unmapMemory(allocation.host.second);  // Host
-    this->device->logical()->destroyBuffer(allocation.host.first.buffer);
-    this->device->logical()->freeMemory(allocation.host.second);
-    this->device->transferPool().freeCommandBuffers(allocation.command);  // Others
-    allocation.fence.destroy();
+    // Create a new one
+    this->batches.push_back({this->device->transferPool().allocateCommandBuffers(vk::CommandBufferLevel::ePrimary, 1).front(),
+                             ao::vulkan::Fence(this->device->logical()), {}});
+    return this->batches.back();
+}
 
-    // Indicate that host buffer is destroyed
-    allocation.host.first.buffer = vk::Buffer();
-    allocation.host.first.ptr = nullptr;
-    allocation.host.first.size = 0;
-}
\ No newline at end of file
+void ao::vulkan::DeviceAllocator::submitBatch(ao::vulkan::DeviceAllocator::Batch& batch, vk::Semaphore signal) {
+    batch.command.end();
+
+    // Wait batches still using the same allocations (e.g. moving them), as they may run on another transfer queue
+    for (auto& other : this->batches) {
+        if (&other == &batch || other.fence.status() == ao::vulkan::FenceStatus::eSignaled) {
+            continue;
+        }
+        if (std::any_of(batch.handles.begin(), batch.handles.end(), [&other](u64 handle) {
+                return std::find(other.handles.begin(), other.handles.end(), handle) != other.handles.end();
+            })) {
+            other.fence.wait();
+        }
+    }
+
+    // Reset fence (just before submission, so that anyone waiting for it will be released)
+    batch.fence.reset();
+
+    // Submit command
+    auto submit_info = vk::SubmitInfo().setCommandBufferCount(1).setPCommandBuffers(&batch.command);
+    if (signal) {
+        submit_info.setSignalSemaphoreCount(1).setPSignalSemaphores(&signal);
+    }
+    this->device->queues()->submit(vk::QueueFlagBits::eTransfer, submit_info, batch.fence);
+}
+
+ao::vulkan::Fence ao::vulkan::DeviceAllocator::submitPending(vk::Semaphore signal) {
+    std::optional<ao::vulkan::StagingRing::Region> region;
+    vk::DeviceSize region_used = 0;
+    vk::DeviceSize remaining = 0;
+
+    // Check pending ranges
+    if (this->pending.empty() && !signal) {
+        return ao::vulkan::Fence();
+    }
+
+    // Count bytes to transfer
+    for (auto& [key, ranges] : this->pending) {
+        for (auto& [begin, end] : ranges) {
+            remaining += end - begin;
+        }
+    }
+
+    auto batch = &this->acquireBatch();
+    batch->command.begin(vk::CommandBufferBeginInfo(this->cmd_usage));
+
+    for (auto& [key, ranges] : this->pending) {
+        auto& allocation = *this->allocations.get(key);
+        std::vector<vk::BufferCopy> copies;
+
+        for (auto& range : ranges) {
+            vk::DeviceSize begin = range.first, end = range.second;
+
+            // Copy directly from host buffer
+            if (!this->staging_ring) {
+                copies.push_back(vk::BufferCopy(begin, allocation.device.first.offset + begin, end - begin));
+                continue;
+            }
+
+            // Copy through staging ring
+            while (begin < end) {
+                if (!region || region_used == region->size) {
+                    // Ring is full, submit what is recorded (waiting for next region orders batches, as it needs the whole ring)
+                    if (region) {
+                        // Region may be filled by previous allocation's ranges
+                        if (!copies.empty()) {
+                            batch->command.copyBuffer(this->staging_ring->buffer(), allocation.device.first.buffer, copies);
+                            batch->handles.push_back(key);
+                            copies.clear();
+                        }
+
+                        this->submitBatch(*batch, vk::Semaphore());
+                        this->staging_ring->submit(*region, batch->fence);
+
+                        batch = &this->acquireBatch();
+                        batch->command.begin(vk::CommandBufferBeginInfo(this->cmd_usage));
+                    }
+
+                    region = this->staging_ring->allocate((std::min)(remaining, this->staging_ring->size()));
+                    region_used = 0;
+                }
+
+                // Copy data into ring
+                vk::DeviceSize bytes = (std::min)(end - begin, region->size - region_used);
+                std::memcpy(static_cast<char*>(region->ptr) + region_used, allocation.shadow.data() + begin, bytes);
+                copies.push_back(vk::BufferCopy(region->offset + region_used, allocation.device.first.offset + begin, bytes));
+
+                region_used += bytes;
+                remaining -= bytes;
+                begin += bytes;
+            }
+        }
+
+        // Record copies
+        if (!copies.empty()) {
+            batch->command.copyBuffer(this->staging_ring ? this->staging_ring->buffer() : allocation.host.first.buffer,
+                                      allocation.device.first.buffer, copies);
+            batch->handles.push_back(key);
+        }
+    }
+    this->pending.clear();
+
+    // Submit
+    this->submitBatch(*batch, signal);
+    if (region) {
+        this->staging_ring->submit(*region, batch->fence);
+    }
+    return batch->fence;
+}
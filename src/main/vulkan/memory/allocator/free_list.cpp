@@ -0,0 +1,87 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include "free_list.h"
+
+#include <algorithm>
+
+#include <ao/core/utilities/memory.h>
+
+#include "../../exception/unknown_allocation.h"
+
+ao::vulkan::FreeList::FreeList(vk::DeviceSize size) : ao::vulkan::SubAllocator(size), used_(0) {
+    this->free_ranges[0] = size;
+}
+
+std::optional<vk::DeviceSize> ao::vulkan::FreeList::allocate(vk::DeviceSize size, vk::DeviceSize alignment) {
+    size = (std::max)(size, vk::DeviceSize(1));
+
+    for (auto it = this->free_ranges.begin(); it != this->free_ranges.end(); it++) {
+        auto [range_offset, range_size] = *it;
+        vk::DeviceSize offset = ao::core::utilities::calculateAligmentSize(range_offset, alignment);
+
+        // Check if range is big enough
+        if (offset + size > range_offset + range_size) {
+            continue;
+        }
+        this->free_ranges.erase(it);
+
+        // Give back padding & remaining space
+        if (offset > range_offset) {
+            this->free_ranges[range_offset] = offset - range_offset;
+        }
+        if (offset + size < range_offset + range_size) {
+            this->free_ranges[offset + size] = (range_offset + range_size) - (offset + size);
+        }
+
+        this->ranges[offset] = size;
+        this->used_ += size;
+        return offset;
+    }
+    return std::nullopt;
+}
+
+void ao::vulkan::FreeList::free(vk::DeviceSize offset) {
+    auto range = this->ranges.find(offset);
+
+    // Check offset
+    if (range == this->ranges.end()) {
+        throw ao::vulkan::UnknownAllocation();
+    }
+
+    vk::DeviceSize size = range->second;
+    this->used_ -= size;
+    this->ranges.erase(range);
+
+    // Insert range
+    auto it = this->free_ranges.emplace(offset, size).first;
+
+    // Merge with next range
+    auto next = std::next(it);
+    if (next != this->free_ranges.end() && it->first + it->second == next->first) {
+        it->second += next->second;
+        this->free_ranges.erase(next);
+    }
+
+    // Merge with previous range
+    if (it != this->free_ranges.begin()) {
+        auto previous = std::prev(it);
+
+        if (previous->first + previous->second == it->first) {
+            previous->second += it->second;
+            this->free_ranges.erase(it);
+        }
+    }
+}
+
+vk::DeviceSize ao::vulkan::FreeList::used() const {
+    return this->used_;
+}
+
+vk::DeviceSize ao::vulkan::FreeList::largestFree() const {
+    auto it = std::max_element(this->free_ranges.begin(), this->free_ranges.end(),
+                               [](auto const& first, auto const& second) { return first.second < second.second; });
+
+    return it != this->free_ranges.end() ? it->second : 0;
+}
@@ -4,87 +4,119 @@
 
 #include "host_allocator.h"
 
+#include <vector>
+
 #include <ao/core/utilities/memory.h>
 
 #include "../../exception/unknown_allocation.h"
-#include "../../utilities/device.h"
-
-ao::vulkan::HostAllocator::HostAllocator(std::shared_ptr<ao::vulkan::Device> device, size_t alignment)
-    : ao::vulkan::Allocator::Allocator(device), alignment(alignment) {}
 
-ao::vulkan::HostAllocator::~HostAllocator() {
-    for (auto& [key, allocation] : this->allocations) {
-        this->device->logical()->unmapMemory(allocation.second);
-        this->device->logical()->destroyBuffer(key);
-        this->device->logical()->freeMemory(allocation.second);
-    }
+ao::vulkan::HostAllocator::HostAllocator(std::shared_ptr<ao::vulkan::Device> device, size_t alignment, vk::DeviceSize block_size)
+    : ao::vulkan::Allocator::Allocator(device),
+      allocated_size(0),
+      pool(device, vk::MemoryPropertyFlagBits::eHostVisible, block_size, ao::vulkan::SubAllocatorType::eFreeList,
+           vk::MemoryPropertyFlagBits::eHostCached),
+      alignment(alignment) {
+    // Track blocks
+    this->pool.setAfterBlockCreation([this](ao::vulkan::MemoryBlock const& block) { this->track(block.memoryType(), block.memorySize()); });
+    this->pool.setBeforeBlockDestruction([this](ao::vulkan::MemoryBlock const& block) { this->untrack(block.memoryType(), block.memorySize()); });
 }
 
 ao::vulkan::Allocator::BufferInfo ao::vulkan::HostAllocator::allocate(vk::DeviceSize size, vk::BufferUsageFlags usage) {
-    // Create buffer
-    auto buffer = this->device->logical()->createBuffer(vk::BufferCreateInfo(vk::BufferCreateFlags(), size, usage, vk::SharingMode::eExclusive));
-
-    // Get memory requirements
-    auto mem_requirements = this->device->logical()->getBufferMemoryRequirements(buffer);
-
-    // Allocate memory
-    auto memory = this->device->logical()->allocateMemory(vk::MemoryAllocateInfo(
-        mem_requirements.size,
-        ao::vulkan::utilities::memoryType(this->device->physical(), mem_requirements.memoryTypeBits,
-                                          vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCached)));
-
-    // Bind memory and buffer
-    this->device->logical()->bindBufferMemory(buffer, memory, 0);
-
-    // Map memory
-    auto ptr = this->device->logical()->mapMemory(memory, 0, mem_requirements.size);
+    // Allocate range
+    ao::vulkan::MemoryPool::Range range;
+    try {
+        std::lock_guard lock(this->pool_mutex);
+        range = this->pool.allocate(size, usage);
+    } catch (vk::SystemError const& error) {
+        this->allocationFailed(error);
+        throw;
+    }
 
     // Add to allocations
-    auto buffer_info = ao::vulkan::Allocator::BufferInfo(mem_requirements.size, buffer, ptr);
-    this->allocations_mutex.lock();
-    this->allocations[buffer] = std::make_pair(buffer_info, memory);
-    this->allocations_mutex.unlock();
-
+    auto buffer_info = ao::vulkan::Allocator::BufferInfo(range.size, range.block->buffer(), range.block->ptr(range.offset), range.offset);
+    buffer_info.coherent = range.block->coherent();
+    buffer_info.handle = this->allocations.insert(range);
+    this->allocated_size += buffer_info.size;
+    this->trackAllocation(buffer_info.size);
+
+    // Evict resources if a new block exceeds budget
+    this->notifyOverBudget();
     return buffer_info;
 }
 
 void ao::vulkan::HostAllocator::invalidate(ao::vulkan::Allocator::BufferInfo const& info, vk::DeviceSize const& offset, vk::DeviceSize const& size) {
     // Check info
-    if (!this->own(info)) {
+    auto range = this->allocations.get(info.handle);
+    if (!range) {
         throw ao::vulkan::UnknownAllocation();
     }
 
-    // Flush memory
-    this->device->logical()->flushMappedMemoryRanges(vk::MappedMemoryRange(this->allocations[info.buffer].second, offset, size));
+    // Flush memory (coherent memory doesn't need it)
+    if (!range->block->coherent()) {
+        this->device->logical()->flushMappedMemoryRanges(range->block->flushRange(range->offset + offset, size));
+    }
 }
 
-void ao::vulkan::HostAllocator::free(Allocator::BufferInfo const& info) {
+void ao::vulkan::HostAllocator::invalidateRanges(ao::vulkan::Allocator::BufferInfo const& info,
+                                                 std::map<vk::DeviceSize, vk::DeviceSize> const& ranges) {
     // Check info
-    if (!this->own(info)) {
+    auto range = this->allocations.get(info.handle);
+    if (!range) {
         throw ao::vulkan::UnknownAllocation();
     }
 
-    // Free
-    auto& allocation = this->allocations[info.buffer];
-    this->device->logical()->unmapMemory(allocation.second);
-    this->device->logical()->destroyBuffer(allocation.first.buffer);
-    this->device->logical()->freeMemory(allocation.second);
+    // Flush memory (coherent memory doesn't need it)
+    if (range->block->coherent()) {
+        return;
+    }
+    std::vector<vk::MappedMemoryRange> memory_ranges;
+    for (auto& [begin, end] : ranges) {
+        memory_ranges.push_back(range->block->flushRange(range->offset + begin, end - begin));
+    }
+    if (!memory_ranges.empty()) {
+        this->device->logical()->flushMappedMemoryRanges(memory_ranges);
+    }
+}
 
-    // Remove from allocations
-    this->allocations_mutex.lock();
-    this->allocations.erase(info.buffer);
-    this->allocations_mutex.unlock();
+void ao::vulkan::HostAllocator::free(Allocator::BufferInfo const& info) {
+    // Remove from allocations, a concurrent free fails
+    auto range = this->allocations.extract(info.handle);
+    if (!range) {
+        throw ao::vulkan::UnknownAllocation();
+    }
+
+    // Free range
+    {
+        std::lock_guard lock(this->pool_mutex);
+        this->pool.free(*range);
+    }
+    this->allocated_size -= range->size;
+    this->untrackAllocation(range->size);
 }
 
 size_t ao::vulkan::HostAllocator::alignSize(size_t size) const {
     return ao::core::utilities::calculateAligmentSize(size, this->alignment);
 }
 
+ao::vulkan::Allocator::Statistics ao::vulkan::HostAllocator::statistics() const {
+    auto statistics = ao::vulkan::Allocator::statistics();
+
+    // Add free space of blocks
+    std::lock_guard lock(this->pool_mutex);
+    this->pool.statistics(statistics.memory_types);
+
+    return statistics;
+}
+
 vk::DeviceSize ao::vulkan::HostAllocator::size() const {
-    return std::accumulate(this->allocations.begin(), this->allocations.end(), vk::DeviceSize(0),
-                           [](vk::DeviceSize result, auto pair) { return result + pair.second.first.size; });
+    return this->allocated_size;
+}
+
+size_t ao::vulkan::HostAllocator::blockCount() const {
+    std::lock_guard lock(this->pool_mutex);
+    return this->pool.blockCount();
 }
 
 bool ao::vulkan::HostAllocator::own(ao::vulkan::Allocator::BufferInfo const& info) const {
-    return this->allocations.count(info.buffer) != 0;
-}
\ No newline at end of file
+    return this->allocations.contains(info.handle);
+}
@@ -4,9 +4,13 @@
 
 #pragma once
 
-#include <tuple>
+#include <atomic>
+#include <mutex>
+
+#include <ao/core/memory/slot_table.hpp>
 
 #include "allocator.h"
+#include "memory_pool.h"
 
 namespace ao::vulkan {
     /**
@@ -15,31 +19,55 @@ namespace ao::vulkan {
      */
     class HostAllocator : public Allocator {
        public:
+        static constexpr vk::DeviceSize DefaultBlockSize = 16 * 1024 * 1024;
+
         /**
          * @brief Construct a new HostAllocator object
          *
          * @param device Device
          * @param alignment Alignment
+         * @param block_size Size of memory blocks, bigger allocations get a dedicated block
          */
-        HostAllocator(std::shared_ptr<Device> device, size_t alignment = 0);
+        HostAllocator(std::shared_ptr<Device> device, size_t alignment = 0, vk::DeviceSize block_size = DefaultBlockSize);
 
         /**
          * @brief Destroy the HostAllocator object
          *
          */
-        virtual ~HostAllocator();
+        virtual ~HostAllocator() = default;
+
+        /**
+         * @brief Get count of memory blocks
+         *
+         * @return size_t Count
+         */
+        size_t blockCount() const;
+
+        /**
+         * @brief Set size above which allocations get dedicated memory instead of being sub-allocated (block's size by default)
+         *
+         * @param threshold Threshold (in bytes)
+         */
+        void setDedicatedThreshold(vk::DeviceSize threshold) {
+            std::lock_guard lock(this->pool_mutex);
+            this->pool.setDedicatedThreshold(threshold);
+        }
 
         virtual void invalidate(BufferInfo const& info, vk::DeviceSize const& offset, vk::DeviceSize const& size) override;
+        virtual void invalidateRanges(BufferInfo const& info, std::map<vk::DeviceSize, vk::DeviceSize> const& ranges) override;
         virtual Allocator::BufferInfo allocate(vk::DeviceSize size, vk::BufferUsageFlags usage) override;
         virtual void free(Allocator::BufferInfo const& info) override;
         virtual bool own(BufferInfo const& info) const override;
         virtual size_t alignSize(size_t size) const override;
         virtual vk::DeviceSize size() const override;
+        virtual Statistics statistics() const override;
 
        protected:
-        std::map<vk::Buffer, std::pair<Allocator::BufferInfo, vk::DeviceMemory>> allocations;
-        std::mutex allocations_mutex;
+        core::SlotTable<MemoryPool::Range> allocations;
+        mutable std::mutex pool_mutex;
+        std::atomic<vk::DeviceSize> allocated_size;
+        MemoryPool pool;
 
         size_t alignment;
     };
-}  // namespace ao::vulkan
\ No newline at end of file
+}  // namespace ao::vulkan
@@ -0,0 +1,103 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include "linear_allocator.h"
+
+#include <algorithm>
+
+#include <ao/core/exception/exception.h>
+#include <ao/core/utilities/memory.h>
+#include <fmt/format.h>
+
+ao::vulkan::LinearAllocator::LinearAllocator(std::shared_ptr<ao::vulkan::Device> device, size_t frames, vk::DeviceSize size,
+                                             vk::BufferUsageFlags usage, size_t alignment)
+    : ao::vulkan::Allocator(device), head(0), current(0), alignment(alignment) {
+    // Check frames
+    if (frames == 0) {
+        throw ao::core::Exception("LinearAllocator needs at least one frame");
+    }
+
+    // Create a buffer per frame
+    for (size_t i = 0; i < frames; i++) {
+        this->blocks.push_back(std::make_unique<ao::vulkan::MemoryBlock>(
+            device, size, usage, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+            ao::vulkan::SubAllocatorType::eFreeList, vk::MemoryPropertyFlagBits::eDeviceLocal));
+        this->track(this->blocks.back()->memoryType(), this->blocks.back()->memorySize());
+    }
+    this->allocations.resize(frames);
+}
+
+ao::vulkan::LinearAllocator::~LinearAllocator() {
+    for (size_t i = 0; i < this->blocks.size(); i++) {
+        for (auto size : this->allocations[i]) {
+            this->untrackAllocation(size);
+        }
+        this->untrack(this->blocks[i]->memoryType(), this->blocks[i]->memorySize());
+    }
+}
+
+void ao::vulkan::LinearAllocator::reset(size_t frame) {
+    this->current = frame % this->blocks.size();
+    this->head = 0;
+
+    // Release frame's allocations
+    std::lock_guard<std::mutex> lock(this->allocations_mutex);
+    for (auto size : this->allocations[this->current]) {
+        this->untrackAllocation(size);
+    }
+    this->allocations[this->current].clear();
+}
+
+void ao::vulkan::LinearAllocator::invalidate([[maybe_unused]] BufferInfo const& info, [[maybe_unused]] vk::DeviceSize const& offset,
+                                             [[maybe_unused]] vk::DeviceSize const& size) {
+    // Memory is host coherent
+}
+
+ao::vulkan::Allocator::BufferInfo ao::vulkan::LinearAllocator::allocate(vk::DeviceSize size, vk::BufferUsageFlags usage) {
+    auto& block = this->blocks[this->current];
+
+    // Check usage
+    if ((usage & block->usage()) != usage) {
+        throw ao::core::Exception(
+            fmt::format("Usage {} isn't supported by LinearAllocator ({})", vk::to_string(usage), vk::to_string(block->usage())));
+    }
+
+    // Bump head
+    vk::DeviceSize aligned_size = ao::core::utilities::calculateAligmentSize(size, block->alignment());
+    vk::DeviceSize offset = this->head.load();
+    do {
+        // Check capacity, head is left untouched so smaller allocations still fit
+        if (offset + aligned_size > block->size()) {
+            throw ao::core::Exception(fmt::format("Frame's buffer is full, fail to allocate {} bytes (capacity: {})", size, block->size()));
+        }
+    } while (!this->head.compare_exchange_weak(offset, offset + aligned_size));
+
+    // Track allocation until frame's reset
+    {
+        std::lock_guard<std::mutex> lock(this->allocations_mutex);
+        this->allocations[this->current].push_back(aligned_size);
+    }
+    this->trackAllocation(aligned_size);
+
+    auto info = ao::vulkan::Allocator::BufferInfo(aligned_size, block->buffer(), block->ptr(offset), offset);
+    info.coherent = true;
+
+    return info;
+}
+
+void ao::vulkan::LinearAllocator::free([[maybe_unused]] Allocator::BufferInfo const& info) {
+    // Memory is released by reset()
+}
+
+bool ao::vulkan::LinearAllocator::own(ao::vulkan::Allocator::BufferInfo const& info) const {
+    return std::any_of(this->blocks.begin(), this->blocks.end(), [&info](auto& block) { return block->buffer() == info.buffer; });
+}
+
+size_t ao::vulkan::LinearAllocator::alignSize(size_t size) const {
+    return ao::core::utilities::calculateAligmentSize(size, this->alignment);
+}
+
+vk::DeviceSize ao::vulkan::LinearAllocator::size() const {
+    return this->head;
+}
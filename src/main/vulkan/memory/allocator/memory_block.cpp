@@ -0,0 +1,88 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include "memory_block.h"
+
+#include <algorithm>
+
+#include <ao/core/utilities/memory.h>
+
+#include "free_list.h"
+#include "tlsf.h"
+
+ao::vulkan::MemoryBlock::MemoryBlock(std::shared_ptr<ao::vulkan::Device> device, vk::DeviceSize size, vk::BufferUsageFlags usage,
+                                     vk::MemoryPropertyFlags memory_flags, ao::vulkan::SubAllocatorType type,
+                                     vk::MemoryPropertyFlags preferred_flags, bool dedicated)
+    : device(device), usage_(usage), dedicated_(dedicated), coherent_(false) {
+    // Ranges must satisfy every offset requirement a buffer can be bound with
+    auto limits = this->device->physical().getProperties().limits;
+    this->atom_size = (std::max)(limits.nonCoherentAtomSize, vk::DeviceSize(1));
+    this->alignment_ = (std::max)({static_cast<vk::DeviceSize>(limits.minMemoryMapAlignment), limits.minTexelBufferOffsetAlignment,
+                                   limits.minUniformBufferOffsetAlignment, limits.minStorageBufferOffsetAlignment});
+    size = ao::core::utilities::calculateAligmentSize(size, this->alignment_);
+
+    // Create sub-allocator (first, as it doesn't own Vulkan resources)
+    switch (type) {
+        case ao::vulkan::SubAllocatorType::eFreeList:
+            this->sub_allocator = std::make_unique<ao::vulkan::FreeList>(size);
+            break;
+
+        case ao::vulkan::SubAllocatorType::eTLSF:
+            this->sub_allocator = std::make_unique<ao::vulkan::TLSF>(size);
+            break;
+
+        default:
+            throw ao::core::Exception("Unknown sub-allocator type");
+    }
+
+    // Create buffer
+    this->buffer_ = this->device->logical()->createBuffer(vk::BufferCreateInfo(vk::BufferCreateFlags(), size, usage, vk::SharingMode::eExclusive));
+
+    try {
+        // Get memory requirements
+        auto mem_requirements = this->device->logical()->getBufferMemoryRequirements(this->buffer_);
+
+        // Allocate memory
+        this->memory_type = this->device->memoryType(mem_requirements.memoryTypeBits, memory_flags, preferred_flags);
+        this->memory_size = mem_requirements.size;
+        auto allocate_info = vk::MemoryAllocateInfo(this->memory_size, this->memory_type);
+        auto dedicated_info = vk::MemoryDedicatedAllocateInfo(vk::Image(), this->buffer_);
+        if (dedicated) {
+            allocate_info.setPNext(&dedicated_info);
+        }
+        this->memory_ = this->device->logical()->allocateMemory(allocate_info);
+
+        // Bind memory and buffer
+        this->device->logical()->bindBufferMemory(this->buffer_, this->memory_, 0);
+
+        // Map memory
+        auto property_flags = this->device->memoryProperties().memoryTypes[this->memory_type].propertyFlags;
+        if (property_flags & vk::MemoryPropertyFlagBits::eHostVisible) {
+            this->mapped = this->device->logical()->mapMemory(this->memory_, 0, mem_requirements.size);
+        }
+        this->coherent_ = static_cast<bool>(property_flags & vk::MemoryPropertyFlagBits::eHostCoherent);
+    } catch (...) {
+        // Destructor isn't called when constructor throws, release what is created
+        if (this->memory_) {
+            this->device->logical()->freeMemory(this->memory_);
+        }
+        this->device->logical()->destroyBuffer(this->buffer_);
+        throw;
+    }
+}
+
+ao::vulkan::MemoryBlock::~MemoryBlock() {
+    if (this->mapped) {
+        this->device->logical()->unmapMemory(this->memory_);
+    }
+    this->device->logical()->destroyBuffer(this->buffer_);
+    this->device->logical()->freeMemory(this->memory_);
+}
+
+vk::MappedMemoryRange ao::vulkan::MemoryBlock::flushRange(vk::DeviceSize offset, vk::DeviceSize size) const {
+    vk::DeviceSize begin = (offset / this->atom_size) * this->atom_size;
+    vk::DeviceSize end = (std::min)(ao::core::utilities::calculateAligmentSize(offset + size, this->atom_size), this->memory_size);
+
+    return vk::MappedMemoryRange(this->memory_, begin, end - begin);
+}
@@ -0,0 +1,213 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#pragma once
+
+#include <ao/core/utilities/optional.h>
+#include <vulkan/vulkan.hpp>
+
+#include "../../wrapper/device.h"
+#include "sub_allocator.h"
+
+namespace ao::vulkan {
+    /**
+     * @brief vk::DeviceMemory block bound to a single vk::Buffer and split into ranges
+     *
+     */
+    class MemoryBlock {
+       public:
+        /**
+         * @brief Construct a new MemoryBlock object
+         *
+         * @param device Device
+         * @param size Block's size
+         * @param usage Buffer usage
+         * @param memory_flags Memory flags, block is persistently mapped if it contains eHostVisible
+         * @param type Sub-allocator type
+         * @param preferred_flags Memory flags to get if a memory type has them
+         * @param dedicated Block holds a single resource, its memory is allocated as a dedicated allocation
+         */
+        MemoryBlock(std::shared_ptr<Device> device, vk::DeviceSize size, vk::BufferUsageFlags usage, vk::MemoryPropertyFlags memory_flags,
+                    SubAllocatorType type = SubAllocatorType::eFreeList, vk::MemoryPropertyFlags preferred_flags = vk::MemoryPropertyFlags(),
+                    bool dedicated = false);
+        MemoryBlock(MemoryBlock const&) = delete;
+
+        /**
+         * @brief Destroy the MemoryBlock object
+         *
+         */
+        virtual ~MemoryBlock();
+
+        /**
+         * @brief Allocate a range
+         *
+         * @param size Range's size
+         * @param alignment Range's alignment
+         * @return std::optional<vk::DeviceSize> Range's offset, std::nullopt if block is full
+         */
+        std::optional<vk::DeviceSize> allocate(vk::DeviceSize size, vk::DeviceSize alignment) {
+            return this->sub_allocator->allocate(size, alignment);
+        }
+
+        /**
+         * @brief Free a range
+         *
+         * @param offset Range's offset
+         */
+        void free(vk::DeviceSize offset) {
+            this->sub_allocator->free(offset);
+        }
+
+        /**
+         * @brief Get pointer to range at {offset}
+         *
+         * @param offset Offset
+         * @return std::optional<void*> Pointer, std::nullopt if block isn't mapped
+         */
+        std::optional<void*> ptr(vk::DeviceSize offset = 0) const {
+            if (!this->mapped) {
+                return std::nullopt;
+            }
+            return static_cast<void*>(static_cast<char*>(*this->mapped) + offset);
+        }
+
+        /**
+         * @brief Get buffer
+         *
+         * @return vk::Buffer Buffer
+         */
+        vk::Buffer buffer() const {
+            return this->buffer_;
+        }
+
+        /**
+         * @brief Get memory
+         *
+         * @return vk::DeviceMemory Memory
+         */
+        vk::DeviceMemory memory() const {
+            return this->memory_;
+        }
+
+        /**
+         * @brief Get memory type index
+         *
+         * @return u32 Memory type
+         */
+        u32 memoryType() const {
+            return this->memory_type;
+        }
+
+        /**
+         * @brief Get size of device memory allocated for block
+         *
+         * @return vk::DeviceSize Size (in bytes)
+         */
+        vk::DeviceSize memorySize() const {
+            return this->memory_size;
+        }
+
+        /**
+         * @brief Check if block's memory is a dedicated allocation
+         *
+         * @return true Block is dedicated
+         * @return false Block is shared
+         */
+        bool dedicated() const {
+            return this->dedicated_;
+        }
+
+        /**
+         * @brief Check if block's memory is host coherent, then mapped writes don't need to be flushed
+         *
+         * @return true Memory is coherent
+         * @return false Memory isn't coherent
+         */
+        bool coherent() const {
+            return this->coherent_;
+        }
+
+        /**
+         * @brief Get memory range to flush for {size} bytes from {offset}, it's aligned on nonCoherentAtomSize
+         * and clamped to block's memory
+         *
+         * @param offset Offset
+         * @param size Size
+         * @return vk::MappedMemoryRange Memory range
+         */
+        vk::MappedMemoryRange flushRange(vk::DeviceSize offset, vk::DeviceSize size) const;
+
+        /**
+         * @brief Get buffer usage
+         *
+         * @return vk::BufferUsageFlags Usage
+         */
+        vk::BufferUsageFlags usage() const {
+            return this->usage_;
+        }
+
+        /**
+         * @brief Get minimal alignment of a range
+         *
+         * @return vk::DeviceSize Alignment
+         */
+        vk::DeviceSize alignment() const {
+            return this->alignment_;
+        }
+
+        /**
+         * @brief Get block's size
+         *
+         * @return vk::DeviceSize Size (in bytes)
+         */
+        vk::DeviceSize size() const {
+            return this->sub_allocator->size();
+        }
+
+        /**
+         * @brief Get memory used in block
+         *
+         * @return vk::DeviceSize Size (in bytes)
+         */
+        vk::DeviceSize used() const {
+            return this->sub_allocator->used();
+        }
+
+        /**
+         * @brief Get size of largest free range
+         *
+         * @return vk::DeviceSize Size (in bytes)
+         */
+        vk::DeviceSize largestFree() const {
+            return this->sub_allocator->largestFree();
+        }
+
+        /**
+         * @brief Check if no range is allocated
+         *
+         * @return true Block is empty
+         * @return false Block isn't empty
+         */
+        bool empty() const {
+            return this->sub_allocator->empty();
+        }
+
+        MemoryBlock& operator=(MemoryBlock const&) = delete;
+
+       protected:
+        std::shared_ptr<Device> device;
+
+        std::unique_ptr<SubAllocator> sub_allocator;
+        std::optional<void*> mapped;
+        vk::BufferUsageFlags usage_;
+        vk::DeviceSize alignment_;
+        vk::DeviceSize atom_size;
+        vk::DeviceSize memory_size;
+        vk::DeviceMemory memory_;
+        u32 memory_type;
+        vk::Buffer buffer_;
+        bool dedicated_;
+        bool coherent_;
+    };
+}  // namespace ao::vulkan
@@ -0,0 +1,162 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include "memory_pool.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include <ao/core/utilities/memory.h>
+
+ao::vulkan::MemoryPool::MemoryPool(std::shared_ptr<ao::vulkan::Device> device, vk::MemoryPropertyFlags memory_flags, vk::DeviceSize block_size,
+                                   ao::vulkan::SubAllocatorType type, vk::MemoryPropertyFlags preferred_flags)
+    : device(device),
+      preferred_flags(preferred_flags),
+      memory_flags(memory_flags),
+      dedicated_threshold(block_size),
+      block_size(block_size),
+      type(type) {}
+
+ao::vulkan::MemoryPool::~MemoryPool() {
+    if (this->before_block_destruction) {
+        for (auto& [usage, blocks] : this->blocks) {
+            for (auto& block : blocks) {
+                this->before_block_destruction(*block);
+            }
+        }
+        for (auto& block : this->dedicated_blocks) {
+            this->before_block_destruction(*block);
+        }
+    }
+}
+
+ao::vulkan::MemoryPool::Range ao::vulkan::MemoryPool::allocate(vk::DeviceSize size, vk::BufferUsageFlags usage) {
+    // Create a dedicated block
+    if (size > this->dedicated_threshold || this->prefersDedicated(usage)) {
+        this->dedicated_blocks.push_back(std::make_unique<ao::vulkan::MemoryBlock>(
+            this->device, size, usage, this->memory_flags, ao::vulkan::SubAllocatorType::eFreeList, this->preferred_flags, true));
+        auto block = this->dedicated_blocks.back().get();
+        if (this->after_block_creation) {
+            this->after_block_creation(*block);
+        }
+        vk::DeviceSize aligned_size = ao::core::utilities::calculateAligmentSize(size, block->alignment());
+
+        return {block, *block->allocate(aligned_size, block->alignment()), aligned_size};
+    }
+
+    // Try to fit in an existing block
+    if (auto range = this->fit(size, usage)) {
+        return *range;
+    }
+
+    // Create a new block
+    auto& blocks = this->blocks[static_cast<VkBufferUsageFlags>(usage)];
+    blocks.push_back(
+        std::make_unique<ao::vulkan::MemoryBlock>(this->device, (std::max)(size, this->block_size), usage, this->memory_flags, this->type,
+                                                      this->preferred_flags));
+    auto block = blocks.back().get();
+    if (this->after_block_creation) {
+        this->after_block_creation(*block);
+    }
+    vk::DeviceSize aligned_size = ao::core::utilities::calculateAligmentSize(size, block->alignment());
+
+    return {block, *block->allocate(aligned_size, block->alignment()), aligned_size};
+}
+
+std::optional<ao::vulkan::MemoryPool::Range> ao::vulkan::MemoryPool::fit(vk::DeviceSize size, vk::BufferUsageFlags usage,
+                                                                         ao::vulkan::MemoryBlock const* excluded) {
+    for (auto& block : this->blocks[static_cast<VkBufferUsageFlags>(usage)]) {
+        if (block.get() == excluded) {
+            continue;
+        }
+        vk::DeviceSize aligned_size = ao::core::utilities::calculateAligmentSize(size, block->alignment());
+
+        if (auto offset = block->allocate(aligned_size, block->alignment())) {
+            return ao::vulkan::MemoryPool::Range{block.get(), *offset, aligned_size};
+        }
+    }
+    return std::nullopt;
+}
+
+void ao::vulkan::MemoryPool::free(ao::vulkan::MemoryPool::Range const& range) {
+    // Release dedicated block
+    if (range.block->dedicated()) {
+        if (this->before_block_destruction) {
+            this->before_block_destruction(*range.block);
+        }
+        this->dedicated_blocks.erase(std::find_if(this->dedicated_blocks.begin(), this->dedicated_blocks.end(),
+                                                  [&range](auto& block) { return block.get() == range.block; }));
+        return;
+    }
+
+    auto& blocks = this->blocks[static_cast<VkBufferUsageFlags>(range.block->usage())];
+
+    // Free range
+    range.block->free(range.offset);
+
+    // Release block, except the last one to avoid re-allocating it on next request
+    if (range.block->empty() && blocks.size() > 1) {
+        if (this->before_block_destruction) {
+            this->before_block_destruction(*range.block);
+        }
+        blocks.erase(std::find_if(blocks.begin(), blocks.end(), [&range](auto& block) { return block.get() == range.block; }));
+    }
+}
+
+size_t ao::vulkan::MemoryPool::blockCount() const {
+    return std::accumulate(this->blocks.begin(), this->blocks.end(), this->dedicated_blocks.size(),
+                           [](size_t result, auto& pair) { return result + pair.second.size(); });
+}
+
+void ao::vulkan::MemoryPool::statistics(std::map<u32, ao::vulkan::Allocator::MemoryTypeStatistics>& statistics) const {
+    auto add = [&statistics](ao::vulkan::MemoryBlock const& block) {
+        auto& type = statistics[block.memoryType()];
+
+        type.free += block.size() - block.used();
+        type.largest_free = (std::max)(type.largest_free, block.largestFree());
+    };
+
+    for (auto& [usage, blocks] : this->blocks) {
+        for (auto& block : blocks) {
+            add(*block);
+        }
+    }
+    for (auto& block : this->dedicated_blocks) {
+        add(*block);
+    }
+}
+
+bool ao::vulkan::MemoryPool::prefersDedicated(vk::BufferUsageFlags usage) {
+    auto it = this->dedicated_usages.find(static_cast<VkBufferUsageFlags>(usage));
+    if (it != this->dedicated_usages.end()) {
+        return it->second;
+    }
+
+    // Query requirements of a probe buffer
+    auto buffer = this->device->logical()->createBuffer(vk::BufferCreateInfo(vk::BufferCreateFlags(), 1, usage, vk::SharingMode::eExclusive));
+    auto requirements = this->device->logical()->getBufferMemoryRequirements2<vk::MemoryRequirements2, vk::MemoryDedicatedRequirements>(
+        vk::BufferMemoryRequirementsInfo2(buffer));
+    this->device->logical()->destroyBuffer(buffer);
+
+    auto& dedicated = requirements.get<vk::MemoryDedicatedRequirements>();
+    return this->dedicated_usages[static_cast<VkBufferUsageFlags>(usage)] =
+               dedicated.prefersDedicatedAllocation || dedicated.requiresDedicatedAllocation;
+}
+
+ao::vulkan::MemoryBlock* ao::vulkan::MemoryPool::defragmentationCandidate() const {
+    ao::vulkan::MemoryBlock* candidate = nullptr;
+
+    for (auto& [usage, blocks] : this->blocks) {
+        if (blocks.size() < 2) {
+            continue;
+        }
+
+        for (auto& block : blocks) {
+            if (!block->empty() && (!candidate || block->used() < candidate->used())) {
+                candidate = block.get();
+            }
+        }
+    }
+    return candidate;
+}
@@ -0,0 +1,160 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <vector>
+
+#include "allocator.h"
+#include "memory_block.h"
+
+namespace ao::vulkan {
+    /**
+     * @brief Set of memory blocks sharing the same memory properties, grouped by buffer usage
+     *
+     */
+    class MemoryPool {
+       public:
+        /**
+         * @brief Range in a memory block
+         *
+         */
+        struct Range {
+            MemoryBlock* block;
+            vk::DeviceSize offset;
+            vk::DeviceSize size;
+        };
+
+        /**
+         * @brief Construct a new MemoryPool object
+         *
+         * @param device Device
+         * @param memory_flags Memory flags of blocks
+         * @param block_size Size of blocks, bigger requests get a dedicated block
+         * @param type Sub-allocator type
+         * @param preferred_flags Memory flags to get if a memory type has them
+         */
+        MemoryPool(std::shared_ptr<Device> device, vk::MemoryPropertyFlags memory_flags, vk::DeviceSize block_size,
+                   SubAllocatorType type = SubAllocatorType::eFreeList, vk::MemoryPropertyFlags preferred_flags = vk::MemoryPropertyFlags());
+        MemoryPool(MemoryPool const&) = delete;
+
+        /**
+         * @brief Destroy the MemoryPool object
+         *
+         */
+        virtual ~MemoryPool();
+
+        /**
+         * @brief Allocate a range. Requests bigger than dedicated threshold, or whose usage is preferred dedicated by driver,
+         * get a dedicated block that is released with them
+         *
+         * @param size Size
+         * @param usage Buffer usage
+         * @return Range Range
+         */
+        Range allocate(vk::DeviceSize size, vk::BufferUsageFlags usage);
+
+        /**
+         * @brief Allocate a range in an existing block
+         *
+         * @param size Size
+         * @param usage Buffer usage
+         * @param excluded Block that mustn't be used, can be null
+         * @return std::optional<Range> Range, std::nullopt if no block can hold it
+         */
+        std::optional<Range> fit(vk::DeviceSize size, vk::BufferUsageFlags usage, MemoryBlock const* excluded = nullptr);
+
+        /**
+         * @brief Free a range, its block is released if it becomes empty and isn't the last block for its usage
+         *
+         * @param range Range
+         */
+        void free(Range const& range);
+
+        /**
+         * @brief Get count of blocks
+         *
+         * @return size_t Count
+         */
+        size_t blockCount() const;
+
+        /**
+         * @brief Add free space of blocks to {statistics}
+         *
+         * @param statistics Statistics of memory types
+         */
+        void statistics(std::map<u32, Allocator::MemoryTypeStatistics>& statistics) const;
+
+        /**
+         * @brief Find the block to empty in order to compact pool: least used block of a usage that has several blocks
+         *
+         * @return MemoryBlock* Block, null if pool can't be compacted
+         */
+        MemoryBlock* defragmentationCandidate() const;
+
+        /**
+         * @brief Set dedicated threshold, bigger requests get a dedicated block (block's size by default)
+         *
+         * @param threshold Threshold (in bytes)
+         */
+        void setDedicatedThreshold(vk::DeviceSize threshold) {
+            this->dedicated_threshold = threshold;
+        }
+
+        /**
+         * @brief Get dedicated threshold
+         *
+         * @return vk::DeviceSize Threshold (in bytes)
+         */
+        vk::DeviceSize dedicatedThreshold() const {
+            return this->dedicated_threshold;
+        }
+
+        /**
+         * @brief Set callback called after a block's creation
+         *
+         * @param callback Callback
+         */
+        void setAfterBlockCreation(std::function<void(MemoryBlock const&)> callback) {
+            this->after_block_creation = callback;
+        }
+
+        /**
+         * @brief Set callback called before a block's destruction
+         *
+         * @param callback Callback
+         */
+        void setBeforeBlockDestruction(std::function<void(MemoryBlock const&)> callback) {
+            this->before_block_destruction = callback;
+        }
+
+        MemoryPool& operator=(MemoryPool const&) = delete;
+
+       protected:
+        std::map<VkBufferUsageFlags, std::vector<std::unique_ptr<MemoryBlock>>> blocks;
+        std::vector<std::unique_ptr<MemoryBlock>> dedicated_blocks;
+        std::map<VkBufferUsageFlags, bool> dedicated_usages;
+        std::function<void(MemoryBlock const&)> before_block_destruction;
+        std::function<void(MemoryBlock const&)> after_block_creation;
+        std::shared_ptr<Device> device;
+
+        vk::MemoryPropertyFlags preferred_flags;
+        vk::MemoryPropertyFlags memory_flags;
+        vk::DeviceSize dedicated_threshold;
+        vk::DeviceSize block_size;
+        SubAllocatorType type;
+
+        /**
+         * @brief Check if driver prefers (or requires) dedicated allocations for buffers of {usage}, answer is cached
+         *
+         * @param usage Buffer usage
+         * @return true Dedicated allocations are preferred
+         * @return false Dedicated allocations aren't preferred
+         */
+        bool prefersDedicated(vk::BufferUsageFlags usage);
+    };
+}  // namespace ao::vulkan
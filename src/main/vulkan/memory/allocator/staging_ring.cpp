@@ -0,0 +1,86 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include "staging_ring.h"
+
+#include <ao/core/exception/exception.h>
+#include <ao/core/utilities/memory.h>
+#include <fmt/format.h>
+
+ao::vulkan::StagingRing::StagingRing(std::shared_ptr<ao::vulkan::Device> device, vk::DeviceSize size)
+    : block(std::make_unique<ao::vulkan::MemoryBlock>(device, size, vk::BufferUsageFlagBits::eTransferSrc,
+                                                      vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)),
+      head(0),
+      used_(0),
+      first_id(0) {}
+
+ao::vulkan::StagingRing::Region ao::vulkan::StagingRing::allocate(vk::DeviceSize size, vk::DeviceSize alignment) {
+    std::unique_lock lock(this->mutex);
+
+    // Check size
+    if (size > this->size()) {
+        throw ao::core::Exception(fmt::format("Region of {} bytes exceeds staging ring's size: {}", size, this->size()));
+    }
+
+    while (true) {
+        // Restart from the beginning when nothing is in flight
+        if (this->segments.empty()) {
+            this->head = 0;
+        }
+
+        // Find region's place, skip ring's end if region doesn't fit before it
+        vk::DeviceSize offset = ao::core::utilities::calculateAligmentSize(this->head, alignment);
+        vk::DeviceSize bytes = offset + size - this->head;
+        if (offset + size > this->size()) {
+            offset = 0;
+            bytes = (this->size() - this->head) + size;
+        }
+
+        // Free space is contiguous from head
+        if (this->used_ + bytes <= this->size()) {
+            this->head = (offset + size) % this->size();
+            this->used_ += bytes;
+            this->segments.push_back({bytes, ao::vulkan::Fence(), false});
+
+            return {offset, size, *this->block->ptr(offset), this->first_id + this->segments.size() - 1};
+        }
+
+        // Wait for space, oldest region may not be submitted yet
+        if (!this->recycle(true)) {
+            this->submission.wait(lock);
+        }
+    }
+}
+
+void ao::vulkan::StagingRing::submit(ao::vulkan::StagingRing::Region const& region, ao::vulkan::Fence fence) {
+    std::lock_guard lock(this->mutex);
+
+    auto& segment = this->segments.at(static_cast<size_t>(region.id - this->first_id));
+    segment.fence = fence;
+    segment.submitted = true;
+
+    this->submission.notify_all();
+}
+
+bool ao::vulkan::StagingRing::recycle(bool wait) {
+    bool recycled = false;
+
+    // Recycle segments in order (a destroyed fence means that its owner already waited for it)
+    while (!this->segments.empty() && this->segments.front().submitted &&
+           (!this->segments.front().fence || this->segments.front().fence.status() == ao::vulkan::FenceStatus::eSignaled)) {
+        this->used_ -= this->segments.front().bytes;
+        this->segments.pop_front();
+        this->first_id++;
+
+        recycled = true;
+    }
+
+    // Wait oldest transfer
+    if (!recycled && wait && !this->segments.empty() && this->segments.front().submitted && this->segments.front().fence) {
+        this->segments.front().fence.wait();
+
+        return this->recycle(false);
+    }
+    return recycled;
+}
@@ -0,0 +1,128 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include <ao/core/utilities/types.h>
+#include <vulkan/vulkan.hpp>
+
+#include "../../wrapper/fence.h"
+#include "memory_block.h"
+
+namespace ao::vulkan {
+    /**
+     * @brief Persistently mapped ring of host memory used as transfer source, regions are recycled once their transfer fence is signaled
+     *
+     */
+    class StagingRing {
+       public:
+        static constexpr vk::DeviceSize DefaultSize = 8 * 1024 * 1024;
+
+        /**
+         * @brief Region in ring
+         *
+         */
+        struct Region {
+            vk::DeviceSize offset;
+            vk::DeviceSize size;
+            void* ptr;
+            u64 id;
+        };
+
+        /**
+         * @brief Construct a new StagingRing object
+         *
+         * @param device Device
+         * @param size Ring's size
+         */
+        explicit StagingRing(std::shared_ptr<Device> device, vk::DeviceSize size = DefaultSize);
+        StagingRing(StagingRing const&) = delete;
+
+        /**
+         * @brief Destroy the StagingRing object
+         *
+         */
+        virtual ~StagingRing() = default;
+
+        /**
+         * @brief Allocate a region, wait for oldest transfers if ring is full.
+         * Every region must be submitted, a thread holding unsubmitted regions must not wait for space
+         *
+         * @param size Region's size
+         * @param alignment Region's alignment
+         * @return Region Region
+         */
+        Region allocate(vk::DeviceSize size, vk::DeviceSize alignment = 1);
+
+        /**
+         * @brief Indicate that {region} is read by a transfer signaling {fence}
+         *
+         * @param region Region
+         * @param fence Fence
+         */
+        void submit(Region const& region, Fence fence);
+
+        /**
+         * @brief Get buffer
+         *
+         * @return vk::Buffer Buffer
+         */
+        vk::Buffer buffer() const {
+            return this->block->buffer();
+        }
+
+        /**
+         * @brief Get ring's size
+         *
+         * @return vk::DeviceSize Size (in bytes)
+         */
+        vk::DeviceSize size() const {
+            return this->block->size();
+        }
+
+        /**
+         * @brief Get memory used by regions in flight
+         *
+         * @return vk::DeviceSize Size (in bytes)
+         */
+        vk::DeviceSize used() const {
+            return this->used_;
+        }
+
+        StagingRing& operator=(StagingRing const&) = delete;
+
+       protected:
+        /**
+         * @brief Segment of ring consumed by a region (padding included)
+         *
+         */
+        struct Segment {
+            vk::DeviceSize bytes;
+            Fence fence;
+            bool submitted;
+        };
+
+        std::unique_ptr<MemoryBlock> block;
+        std::deque<Segment> segments;
+        std::condition_variable submission;
+        std::mutex mutex;
+
+        vk::DeviceSize head;
+        vk::DeviceSize used_;
+        u64 first_id;
+
+        /**
+         * @brief Recycle segments whose transfer is over
+         *
+         * @param wait Wait oldest transfer if nothing can be recycled
+         * @return true Some memory has been recycled
+         * @return false Nothing has been recycled
+         */
+        bool recycle(bool wait);
+    };
+}  // namespace ao::vulkan
@@ -0,0 +1,91 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#pragma once
+
+#include <ao/core/utilities/optional.h>
+#include <vulkan/vulkan.hpp>
+
+namespace ao::vulkan {
+    /**
+     * @brief Sub-allocator types
+     *
+     */
+    enum class SubAllocatorType { eFreeList, eTLSF };
+
+    /**
+     * @brief Strategy that carves ranges out of a memory block
+     *
+     */
+    class SubAllocator {
+       public:
+        /**
+         * @brief Construct a new SubAllocator object
+         *
+         * @param size Size of managed range
+         */
+        explicit SubAllocator(vk::DeviceSize size) : size_(size) {}
+        SubAllocator(SubAllocator const&) = delete;
+
+        /**
+         * @brief Destroy the SubAllocator object
+         *
+         */
+        virtual ~SubAllocator() = default;
+
+        /**
+         * @brief Allocate a range
+         *
+         * @param size Range's size
+         * @param alignment Range's alignment (power of two)
+         * @return std::optional<vk::DeviceSize> Range's offset, std::nullopt if there is no space left
+         */
+        virtual std::optional<vk::DeviceSize> allocate(vk::DeviceSize size, vk::DeviceSize alignment) = 0;
+
+        /**
+         * @brief Free a range
+         *
+         * @param offset Range's offset
+         */
+        virtual void free(vk::DeviceSize offset) = 0;
+
+        /**
+         * @brief Get memory used
+         *
+         * @return vk::DeviceSize Memory size (in bytes)
+         */
+        virtual vk::DeviceSize used() const = 0;
+
+        /**
+         * @brief Get size of largest free range, allocations bigger than it can't fit (fragmentation indicator)
+         *
+         * @return vk::DeviceSize Size (in bytes)
+         */
+        virtual vk::DeviceSize largestFree() const = 0;
+
+        /**
+         * @brief Get size of managed range
+         *
+         * @return vk::DeviceSize Size (in bytes)
+         */
+        vk::DeviceSize size() const {
+            return this->size_;
+        }
+
+        /**
+         * @brief Check if no range is allocated
+         *
+         * @return true Nothing is allocated
+         * @return false Some ranges are allocated
+         */
+        bool empty() const {
+            return this->used() == 0;
+        }
+
+        SubAllocator& operator=(SubAllocator const&) = delete;
+
+       protected:
+        vk::DeviceSize size_;
+    };
+}  // namespace ao::vulkan
@@ -0,0 +1,264 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include "tlsf.h"
+
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#    include <intrin.h>
+#endif
+
+#include <ao/core/utilities/memory.h>
+
+#include "../../exception/unknown_allocation.h"
+
+namespace {
+    /**
+     * @brief Index of most significant bit
+     *
+     * @param value Value (not 0)
+     * @return u32 Index
+     */
+    inline u32 msb(u64 value) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return static_cast<u32>(index);
+#else
+        return 63 - static_cast<u32>(__builtin_clzll(value));
+#endif
+    }
+
+    /**
+     * @brief Index of least significant bit
+     *
+     * @param value Value (not 0)
+     * @return u32 Index
+     */
+    inline u32 lsb(u64 value) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return static_cast<u32>(index);
+#else
+        return static_cast<u32>(__builtin_ctzll(value));
+#endif
+    }
+
+    /**
+     * @brief Map a size to its free list indices
+     *
+     * @param size Size
+     * @return std::pair<u32, u32> First & second level indices
+     */
+    inline std::pair<u32, u32> mapping(vk::DeviceSize size) {
+        if (size < ao::vulkan::TLSF::SecondLevelCount) {
+            return std::make_pair(0, static_cast<u32>(size));
+        }
+
+        u32 bit = msb(size);
+        return std::make_pair(bit - ao::vulkan::TLSF::SecondLevelLog2 + 1,
+                              static_cast<u32>(size >> (bit - ao::vulkan::TLSF::SecondLevelLog2)) ^ ao::vulkan::TLSF::SecondLevelCount);
+    }
+}  // namespace
+
+ao::vulkan::TLSF::TLSF(vk::DeviceSize size) : ao::vulkan::SubAllocator(size), first_level_bitmap(0), used_(0) {
+    for (auto& lists : this->free_lists) {
+        lists.fill(nullptr);
+    }
+    this->second_level_bitmaps.fill(0);
+
+    // Whole range is free
+    auto block = this->acquire(0, size);
+    block->free = true;
+    this->insert(block);
+}
+
+std::optional<vk::DeviceSize> ao::vulkan::TLSF::allocate(vk::DeviceSize size, vk::DeviceSize alignment) {
+    size = (std::max)(size, vk::DeviceSize(1));
+
+    // Find a block that fits even with the worst padding
+    Block* block = this->find(size + (alignment > 1 ? alignment - 1 : 0));
+    if (!block) {
+        return std::nullopt;
+    }
+    this->remove(block);
+
+    // Keep padding free
+    vk::DeviceSize padding = ao::core::utilities::calculateAligmentSize(block->offset, alignment) - block->offset;
+    if (padding > 0) {
+        Block* aligned = this->split(block, padding);
+
+        this->remove(aligned);
+        this->insert(block);
+        block = aligned;
+    }
+
+    // Give back remaining space
+    if (block->size > size) {
+        this->split(block, size);
+    }
+
+    block->free = false;
+    this->used_blocks[block->offset] = block;
+    this->used_ += block->size;
+    return block->offset;
+}
+
+void ao::vulkan::TLSF::free(vk::DeviceSize offset) {
+    auto it = this->used_blocks.find(offset);
+
+    // Check offset
+    if (it == this->used_blocks.end()) {
+        throw ao::vulkan::UnknownAllocation();
+    }
+
+    Block* block = it->second;
+    this->used_blocks.erase(it);
+    this->used_ -= block->size;
+    block->free = true;
+
+    // Merge with free neighbours
+    if (block->previous_physical && block->previous_physical->free) {
+        this->remove(block->previous_physical);
+        block = this->merge(block);
+    }
+    if (block->next_physical && block->next_physical->free) {
+        this->remove(block->next_physical);
+        block = this->merge(block->next_physical);
+    }
+
+    this->insert(block);
+}
+
+vk::DeviceSize ao::vulkan::TLSF::used() const {
+    return this->used_;
+}
+
+vk::DeviceSize ao::vulkan::TLSF::largestFree() const {
+    vk::DeviceSize largest = 0;
+
+    for (auto& lists : this->free_lists) {
+        for (Block* block : lists) {
+            for (; block; block = block->next_free) {
+                largest = (std::max)(largest, block->size);
+            }
+        }
+    }
+    return largest;
+}
+
+ao::vulkan::TLSF::Block* ao::vulkan::TLSF::acquire(vk::DeviceSize offset, vk::DeviceSize size) {
+    Block* block;
+
+    if (this->spare_blocks.empty()) {
+        this->blocks.push_back(std::make_unique<Block>());
+        block = this->blocks.back().get();
+    } else {
+        block = this->spare_blocks.back();
+        this->spare_blocks.pop_back();
+    }
+
+    *block = {offset, size, false, nullptr, nullptr, nullptr, nullptr};
+    return block;
+}
+
+void ao::vulkan::TLSF::release(Block* block) {
+    this->spare_blocks.push_back(block);
+}
+
+void ao::vulkan::TLSF::insert(Block* block) {
+    auto [first, second] = mapping(block->size);
+    Block*& head = this->free_lists[first][second];
+
+    // Push front
+    block->previous_free = nullptr;
+    block->next_free = head;
+    if (head) {
+        head->previous_free = block;
+    }
+    head = block;
+
+    // Update bitmaps
+    this->first_level_bitmap |= u64(1) << first;
+    this->second_level_bitmaps[first] |= 1u << second;
+}
+
+void ao::vulkan::TLSF::remove(Block* block) {
+    auto [first, second] = mapping(block->size);
+
+    // Unlink
+    if (block->previous_free) {
+        block->previous_free->next_free = block->next_free;
+    } else {
+        this->free_lists[first][second] = block->next_free;
+    }
+    if (block->next_free) {
+        block->next_free->previous_free = block->previous_free;
+    }
+    block->previous_free = block->next_free = nullptr;
+
+    // Update bitmaps
+    if (!this->free_lists[first][second]) {
+        this->second_level_bitmaps[first] &= ~(1u << second);
+
+        if (!this->second_level_bitmaps[first]) {
+            this->first_level_bitmap &= ~(u64(1) << first);
+        }
+    }
+}
+
+ao::vulkan::TLSF::Block* ao::vulkan::TLSF::split(Block* block, vk::DeviceSize size) {
+    Block* remaining = this->acquire(block->offset + size, block->size - size);
+
+    // Link neighbours
+    remaining->free = true;
+    remaining->previous_physical = block;
+    remaining->next_physical = block->next_physical;
+    if (block->next_physical) {
+        block->next_physical->previous_physical = remaining;
+    }
+    block->next_physical = remaining;
+    block->size = size;
+
+    this->insert(remaining);
+    return remaining;
+}
+
+ao::vulkan::TLSF::Block* ao::vulkan::TLSF::merge(Block* block) {
+    Block* previous = block->previous_physical;
+
+    // Absorb block
+    previous->size += block->size;
+    previous->next_physical = block->next_physical;
+    if (block->next_physical) {
+        block->next_physical->previous_physical = previous;
+    }
+
+    this->release(block);
+    return previous;
+}
+
+ao::vulkan::TLSF::Block* ao::vulkan::TLSF::find(vk::DeviceSize size) const {
+    // Round up to the next list so that any block in it is big enough
+    if (size >= SecondLevelCount) {
+        size += (u64(1) << (msb(size) - SecondLevelLog2)) - 1;
+    }
+    auto [first, second] = mapping(size);
+
+    // Search in same first level
+    u32 second_map = first < FirstLevelCount ? this->second_level_bitmaps[first] & (~0u << second) : 0;
+    if (!second_map) {
+        // Search in upper first levels
+        u64 first_map = first + 1 < FirstLevelCount ? this->first_level_bitmap & (~u64(0) << (first + 1)) : 0;
+        if (!first_map) {
+            return nullptr;
+        }
+
+        first = lsb(first_map);
+        second_map = this->second_level_bitmaps[first];
+    }
+    return this->free_lists[first][lsb(second_map)];
+}
@@ -0,0 +1,125 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <ao/core/utilities/types.h>
+
+#include "sub_allocator.h"
+
+namespace ao::vulkan {
+    /**
+     * @brief Two-level segregated fit sub-allocator, allocate() and free() are O(1)
+     *
+     */
+    class TLSF : public SubAllocator {
+       public:
+        static constexpr u32 SecondLevelLog2 = 4;
+        static constexpr u32 SecondLevelCount = 1 << SecondLevelLog2;
+        static constexpr u32 FirstLevelCount = 64;
+
+        /**
+         * @brief Construct a new TLSF object
+         *
+         * @param size Size of managed range
+         */
+        explicit TLSF(vk::DeviceSize size);
+
+        /**
+         * @brief Destroy the TLSF object
+         *
+         */
+        virtual ~TLSF() = default;
+
+        virtual std::optional<vk::DeviceSize> allocate(vk::DeviceSize size, vk::DeviceSize alignment) override;
+        virtual void free(vk::DeviceSize offset) override;
+        virtual vk::DeviceSize used() const override;
+        virtual vk::DeviceSize largestFree() const override;
+
+       protected:
+        /**
+         * @brief Physical block, linked to its neighbours and to its free list when it isn't used
+         *
+         */
+        struct Block {
+            vk::DeviceSize offset;
+            vk::DeviceSize size;
+            bool free;
+
+            Block* previous_physical;
+            Block* next_physical;
+            Block* previous_free;
+            Block* next_free;
+        };
+
+        std::array<std::array<Block*, SecondLevelCount>, FirstLevelCount> free_lists;
+        std::array<u32, FirstLevelCount> second_level_bitmaps;
+        u64 first_level_bitmap;
+
+        std::unordered_map<vk::DeviceSize, Block*> used_blocks;
+        std::vector<std::unique_ptr<Block>> blocks;
+        std::vector<Block*> spare_blocks;
+        vk::DeviceSize used_;
+
+        /**
+         * @brief Get a block from the pool
+         *
+         * @param offset Offset
+         * @param size Size
+         * @return Block* Block
+         */
+        Block* acquire(vk::DeviceSize offset, vk::DeviceSize size);
+
+        /**
+         * @brief Give back a block to the pool
+         *
+         * @param block Block
+         */
+        void release(Block* block);
+
+        /**
+         * @brief Insert a block in its free list
+         *
+         * @param block Block
+         */
+        void insert(Block* block);
+
+        /**
+         * @brief Remove a block from its free list
+         *
+         * @param block Block
+         */
+        void remove(Block* block);
+
+        /**
+         * @brief Split {block} at {size}, remaining space is inserted in free lists
+         *
+         * @param block Block
+         * @param size Size to keep in block
+         * @return Block* Remaining block
+         */
+        Block* split(Block* block, vk::DeviceSize size);
+
+        /**
+         * @brief Merge {block} into its previous physical neighbour
+         *
+         * @param block Block
+         * @return Block* Merged block
+         */
+        Block* merge(Block* block);
+
+        /**
+         * @brief Find a free block of at least {size} bytes
+         *
+         * @param size Size
+         * @return Block* Block, nullptr if there is no such block
+         */
+        Block* find(vk::DeviceSize size) const;
+    };
+}  // namespace ao::vulkan
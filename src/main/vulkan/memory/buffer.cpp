@@ -4,11 +4,75 @@
 
 #include "buffer.h"
 
+#include <algorithm>
+
+#include <ao/core/utilities/memory.h>
+
 ao::vulkan::Buffer::Buffer(std::shared_ptr<Allocator> allocator, vk::DeviceSize size, vk::BufferUsageFlags usage)
-    : allocator_(allocator), buffer_info(std::make_unique<ao::vulkan::Allocator::BufferInfo>(allocator->allocate(size, usage))) {}
+    : allocator_(allocator), buffer_info(std::make_unique<ao::vulkan::Allocator::BufferInfo>(allocator->allocate(size, usage))), usage(usage) {
+    this->followRelocations();
+}
 
 ao::vulkan::Buffer::~Buffer() {
     if (this->allocator_->own(*this->buffer_info)) {
         this->allocator_->free(*this->buffer_info);
     }
-}
\ No newline at end of file
+}
+
+void ao::vulkan::Buffer::reallocate(vk::DeviceSize size, vk::DeviceSize copy_size) {
+    auto info = std::make_unique<ao::vulkan::Allocator::BufferInfo>(this->allocator_->allocate(size, this->usage));
+
+    // Copy content
+    this->allocator_->copy(*this->buffer_info, *info, (std::min)({copy_size, this->buffer_info->size, info->size}));
+
+    // Drop dirty ranges out of new buffer
+    for (auto it = this->dirty_ranges.begin(); it != this->dirty_ranges.end();) {
+        if (it->first >= info->size) {
+            it = this->dirty_ranges.erase(it);
+            continue;
+        }
+        it->second = (std::min)(it->second, info->size);
+        it++;
+    }
+
+    // Free old buffer
+    this->allocator_->free(*this->buffer_info);
+    this->buffer_info = std::move(info);
+    this->followRelocations();
+
+    if (this->after_relocation) {
+        this->after_relocation(*this->buffer_info);
+    }
+}
+
+void ao::vulkan::Buffer::markDirty(vk::DeviceSize offset, vk::DeviceSize size) {
+    if (size > 0) {
+        ao::core::utilities::mergeRange(this->dirty_ranges, offset, offset + size);
+    }
+}
+
+void ao::vulkan::Buffer::flush() {
+    if (this->dirty_ranges.empty()) {
+        return;
+    }
+
+    // Coherent memory is already seen by device
+    if (this->buffer_info->coherent) {
+        this->dirty_ranges.clear();
+        return;
+    }
+
+    this->allocator_->invalidateRanges(*this->buffer_info, this->dirty_ranges);
+    this->dirty_ranges.clear();
+}
+
+void ao::vulkan::Buffer::followRelocations() {
+    this->allocator_->setRelocationCallback(*this->buffer_info, [this](vk::Buffer buffer, vk::DeviceSize offset) {
+        this->buffer_info->buffer = buffer;
+        this->buffer_info->offset = offset;
+
+        if (this->after_relocation) {
+            this->after_relocation(*this->buffer_info);
+        }
+    });
+}
@@ -4,6 +4,12 @@
 
 #pragma once
 
+#include <functional>
+#include <map>
+
+#include <ao/core/exception/exception.h>
+#include <ao/core/memory/span.hpp>
+#include <fmt/format.h>
 #include <vulkan/vulkan.hpp>
 
 #include "allocator/allocator.h"
@@ -48,6 +54,45 @@ namespace ao::vulkan {
             return this->allocator_;
         }
 
+        /**
+         * @brief Get a typed view on mapped memory from {offset} to buffer's end, writes through it must be invalidated
+         * unless buffer is coherent. View is invalidated by buffer's reallocation
+         *
+         * @tparam T Type of elements
+         * @param offset Offset (in bytes)
+         * @return core::Span<T> View
+         */
+        template<class T>
+        core::Span<T> span(vk::DeviceSize offset = 0) const {
+            if (!this->buffer_info->ptr) {
+                throw core::Exception("Buffer isn't mapped");
+            }
+            if (offset > this->buffer_info->size) {
+                throw core::Exception(fmt::format("Offset {} is out of buffer ({} bytes)", offset, this->buffer_info->size));
+            }
+            return core::Span<T>(reinterpret_cast<T*>(static_cast<char*>(*this->buffer_info->ptr) + offset),
+                                 static_cast<size_t>((this->buffer_info->size - offset) / sizeof(T)));
+        }
+
+        /**
+         * @brief Check if writes through mapped memory are seen by device without invalidation
+         *
+         * @return true Buffer is coherent
+         * @return false Buffer isn't coherent
+         */
+        bool coherent() const {
+            return this->buffer_info->coherent;
+        }
+
+        /**
+         * @brief Set callback called after buffer's relocation by its allocator or its reallocation (command buffers using it must be updated)
+         *
+         * @param callback Callback
+         */
+        void setAfterRelocation(std::function<void(Allocator::BufferInfo const&)> callback) {
+            this->after_relocation = callback;
+        }
+
         /**
          * @brief Invalidate entire buffer
          *
@@ -56,8 +101,51 @@ namespace ao::vulkan {
             this->allocator_->invalidate(*this->buffer_info, 0, this->buffer_info->size);
         }
 
+        /**
+         * @brief Mark {size} bytes from {offset} as modified, overlapping or adjacent ranges are merged.
+         * Allocator isn't notified until flush()
+         *
+         * @param offset Offset
+         * @param size Size
+         */
+        void markDirty(vk::DeviceSize offset, vk::DeviceSize size);
+
+        /**
+         * @brief Invalidate dirty ranges at once
+         *
+         */
+        void flush();
+
+        /**
+         * @brief Check if buffer has dirty ranges
+         *
+         * @return true Buffer is dirty
+         * @return false Buffer isn't dirty
+         */
+        bool dirty() const {
+            return !this->dirty_ranges.empty();
+        }
+
        protected:
+        std::function<void(Allocator::BufferInfo const&)> after_relocation;
         std::shared_ptr<Allocator> allocator_;
         std::unique_ptr<Allocator::BufferInfo> buffer_info;
+        std::map<vk::DeviceSize, vk::DeviceSize> dirty_ranges;
+        vk::BufferUsageFlags usage;
+
+        /**
+         * @brief Replace buffer with a new one of {size} bytes, the first {copy_size} bytes are copied by allocator
+         * (on device for DeviceAllocator) and the old buffer is freed
+         *
+         * @param size New size
+         * @param copy_size Size to copy
+         */
+        void reallocate(vk::DeviceSize size, vk::DeviceSize copy_size);
+
+        /**
+         * @brief Follow relocations of current allocation
+         *
+         */
+        void followRelocations();
     };
 }  // namespace ao::vulkan
\ No newline at end of file
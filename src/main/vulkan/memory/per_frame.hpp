@@ -0,0 +1,160 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#pragma once
+
+#include <ao/core/exception/exception.h>
+
+#include "allocator/allocator.h"
+#include "buffer.h"
+
+namespace ao::vulkan {
+    /**
+     * @brief Vulkan buffer holding a copy of {T} per frame in flight in a single allocation, so that CPU writes frame N + 1
+     * while GPU reads frame N. Bind it as a dynamic uniform buffer (range: sizeof(T)) with dynamicOffset(), allocator's alignment
+     * must satisfy minUniformBufferOffsetAlignment
+     *
+     * @tparam T Type of per-frame data
+     */
+    template<class T>
+    class PerFrame : public Buffer {
+       public:
+        /**
+         * @brief Construct a new PerFrame object
+         *
+         * @param frames Count of frames in flight
+         * @param allocator Allocator
+         * @param usage Buffer usage
+         */
+        PerFrame(size_t frames, std::shared_ptr<Allocator> allocator, vk::BufferUsageFlags usage = vk::BufferUsageFlagBits::eUniformBuffer)
+            : Buffer(allocator, PerFrame::checkFrames(frames) * allocator->alignSize(sizeof(T)), usage),
+              frames_(frames),
+              current(0),
+              stride(allocator->alignSize(sizeof(T))) {}
+
+        /**
+         * @brief Destroy the PerFrame object
+         *
+         */
+        virtual ~PerFrame() = default;
+
+        /**
+         * @brief Make {frame} the current frame (Engine's current frame)
+         *
+         * @param frame Frame index
+         */
+        void rotate(size_t frame) {
+            this->current = frame % this->frames_;
+        }
+
+        /**
+         * @brief Get current frame
+         *
+         * @return size_t Frame index
+         */
+        size_t frame() const {
+            return this->current;
+        }
+
+        /**
+         * @brief Get count of frames
+         *
+         * @return size_t Count
+         */
+        size_t frames() const {
+            return this->frames_;
+        }
+
+        /**
+         * @brief Get data of {frame}
+         *
+         * @param frame Frame index
+         * @return T& Data
+         */
+        T& operator[](size_t frame) {
+            return *reinterpret_cast<T*>(static_cast<char*>(*this->buffer_info->ptr) + this->relativeOffset(frame));
+        }
+
+        /**
+         * @brief Get data of current frame
+         *
+         * @return T& Data
+         */
+        T& operator*() {
+            return (*this)[this->current];
+        }
+
+        /**
+         * @brief Get data of current frame
+         *
+         * @return T* Data
+         */
+        T* operator->() {
+            return &(*this)[this->current];
+        }
+
+        /**
+         * @brief Get offset of {frame}'s data in info().buffer, to bind it
+         *
+         * @param frame Frame index
+         * @return vk::DeviceSize Offset
+         */
+        vk::DeviceSize offset(size_t frame) const {
+            return this->buffer_info->offset + this->relativeOffset(frame);
+        }
+
+        /**
+         * @brief Get offset of {frame}'s data from start of allocation (info().ptr)
+         *
+         * @param frame Frame index
+         * @return vk::DeviceSize Offset
+         */
+        vk::DeviceSize relativeOffset(size_t frame) const {
+            return frame * this->stride;
+        }
+
+        /**
+         * @brief Get dynamic offset of current frame (descriptor's offset is buffer's offset)
+         *
+         * @return u32 Offset
+         */
+        u32 dynamicOffset() const {
+            return static_cast<u32>(this->relativeOffset(this->current));
+        }
+
+        /**
+         * @brief Invalidate current frame's data
+         *
+         */
+        void invalidate() {
+            this->allocator_->invalidate(*this->buffer_info, this->relativeOffset(this->current), sizeof(T));
+        }
+
+        /**
+         * @brief Mark current frame's data as dirty, it's invalidated by flush()
+         *
+         */
+        void markDirty() {
+            Buffer::markDirty(this->relativeOffset(this->current), sizeof(T));
+        }
+
+       protected:
+        size_t frames_;
+        size_t current;
+        size_t stride;
+
+        /**
+         * @brief Check count of frames (before allocation)
+         *
+         * @param frames Count of frames
+         * @return size_t Count of frames
+         */
+        static size_t checkFrames(size_t frames) {
+            if (frames == 0) {
+                throw core::Exception("PerFrame needs at least one frame");
+            }
+            return frames;
+        }
+    };
+}  // namespace ao::vulkan
@@ -0,0 +1,257 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#pragma once
+
+#include <array>
+#include <tuple>
+
+#include <ao/core/memory/ptr_iterator.hpp>
+#include <ao/core/utilities/memory.h>
+
+#include "allocator/allocator.h"
+#include "buffer.h"
+
+namespace ao::vulkan {
+    /**
+     * @brief View on a column of a structure-of-arrays buffer
+     *
+     * @tparam T Type of elements
+     */
+    template<class T>
+    class Column {
+       public:
+        /**
+         * @brief Construct a new Column object
+         *
+         * @param data Pointer to first element
+         * @param size Count of elements
+         * @param offset Column's offset in buffer
+         */
+        Column(T* data, size_t size, vk::DeviceSize offset) : data_(data), size_(size), offset_(offset) {}
+
+        /**
+         * @brief Operator[]
+         *
+         * @param index Index
+         * @return T& Value
+         */
+        T& operator[](size_t index) {
+            return this->data_[index];
+        }
+
+        /**
+         * @brief Get pointer to first element
+         *
+         * @return T* Pointer
+         */
+        T* data() {
+            return this->data_;
+        }
+
+        /**
+         * @brief Get count of elements
+         *
+         * @return size_t Count
+         */
+        size_t size() const {
+            return this->size_;
+        }
+
+        /**
+         * @brief Get column's offset in buffer (to bind it as a vertex buffer or a storage buffer)
+         *
+         * @return vk::DeviceSize Offset
+         */
+        vk::DeviceSize offset() const {
+            return this->offset_;
+        }
+
+        /**
+         * @brief Get begin iterator
+         *
+         * @return core::PtrIterator<T> Iterator
+         */
+        core::PtrIterator<T> begin() {
+            return core::PtrIterator<T>(this->data_);
+        }
+
+        /**
+         * @brief Get end iterator
+         *
+         * @return core::PtrIterator<T> Iterator
+         */
+        core::PtrIterator<T> end() {
+            return core::PtrIterator<T>(this->data_ + this->size_);
+        }
+
+       protected:
+        T* data_;
+        size_t size_;
+        vk::DeviceSize offset_;
+    };
+
+    /**
+     * @brief Vulkan buffer with a structure-of-arrays layout: each field is stored in its own aligned column,
+     * so that shaders reading a few fields only stream these columns. Count of elements is set at construction, it can't be resized.
+     * Columns are aligned on allocator's alignment (it must satisfy minStorageBufferOffsetAlignment to bind them as storage buffers)
+     * and on their field's alignment
+     *
+     * @tparam Fields Types of fields
+     */
+    template<class... Fields>
+    class SoaArray : public Buffer {
+       public:
+        /**
+         * @brief Field's type at {Index}
+         *
+         * @tparam Index Field's index
+         */
+        template<size_t Index>
+        using Field = typename std::tuple_element<Index, std::tuple<Fields...>>::type;
+
+        /**
+         * @brief Construct a new SoaArray object
+         *
+         * @param size Count of elements
+         * @param allocator Allocator
+         * @param usage Buffer usage
+         */
+        SoaArray(size_t size, std::shared_ptr<Allocator> allocator, vk::BufferUsageFlags usage = vk::BufferUsageFlags())
+            : SoaArray(size, SoaArray::layout(size, allocator), allocator, usage) {}
+
+        /**
+         * @brief Destroy the SoaArray object
+         *
+         */
+        virtual ~SoaArray() = default;
+
+        /**
+         * @brief Get column of field {Index}
+         *
+         * @tparam Index Field's index
+         * @return Column<Field<Index>> Column
+         */
+        template<size_t Index>
+        Column<Field<Index>> column() {
+            return Column<Field<Index>>(reinterpret_cast<Field<Index>*>(static_cast<char*>(*this->buffer_info->ptr) + this->offsets[Index]),
+                                        this->size_, this->offset<Index>());
+        }
+
+        /**
+         * @brief Get offset of field {Index}'s column in info().buffer, to bind it
+         *
+         * @tparam Index Field's index
+         * @return vk::DeviceSize Offset
+         */
+        template<size_t Index>
+        vk::DeviceSize offset() const {
+            return this->buffer_info->offset + this->offsets[Index];
+        }
+
+        /**
+         * @brief Get count of elements
+         *
+         * @return size_t Count
+         */
+        size_t size() const {
+            return this->size_;
+        }
+
+        /**
+         * @brief Invalidate {count} elements from {index} of field {Index}'s column
+         *
+         * @tparam Index Field's index
+         * @param index Index
+         * @param count Count
+         */
+        template<size_t Index>
+        void invalidate(size_t index = 0, size_t count = 1) {
+            this->allocator_->invalidate(*this->buffer_info, this->offsets[Index] + index * sizeof(Field<Index>), count * sizeof(Field<Index>));
+        }
+
+        /**
+         * @brief Invalidate field {Index}'s column
+         *
+         * @tparam Index Field's index
+         */
+        template<size_t Index>
+        void invalidateColumn() {
+            this->template invalidate<Index>(0, this->size_);
+        }
+
+        /**
+         * @brief Mark {count} elements from {index} of field {Index}'s column as dirty, they're invalidated by flush()
+         *
+         * @tparam Index Field's index
+         * @param index Index
+         * @param count Count
+         */
+        template<size_t Index>
+        void markDirty(size_t index, size_t count = 1) {
+            Buffer::markDirty(this->offsets[Index] + index * sizeof(Field<Index>), count * sizeof(Field<Index>));
+        }
+
+       protected:
+        std::array<vk::DeviceSize, sizeof...(Fields) + 1> offsets;
+        size_t size_;
+
+        /**
+         * @brief Construct a new SoaArray object
+         *
+         * @param size Count of elements
+         * @param offsets Columns' offsets, last one is buffer's size
+         * @param allocator Allocator
+         * @param usage Buffer usage
+         */
+        SoaArray(size_t size, std::array<vk::DeviceSize, sizeof...(Fields) + 1> const& offsets, std::shared_ptr<Allocator> allocator,
+                 vk::BufferUsageFlags usage)
+            : Buffer(allocator, offsets.back(), usage), offsets(offsets), size_(size) {}
+
+        /**
+         * @brief Compute columns' offsets
+         *
+         * @param size Count of elements
+         * @param allocator Allocator
+         * @return std::array<vk::DeviceSize, sizeof...(Fields) + 1> Offsets, last one is buffer's size
+         */
+        static std::array<vk::DeviceSize, sizeof...(Fields) + 1> layout(size_t size, std::shared_ptr<Allocator> allocator) {
+            std::array<vk::DeviceSize, sizeof...(Fields) + 1> offsets;
+            vk::DeviceSize sizes[] = {static_cast<vk::DeviceSize>(size * sizeof(Fields))...};
+            vk::DeviceSize alignments[] = {static_cast<vk::DeviceSize>(alignof(Fields))..., 1};
+
+            // Pad each column up to next column's alignment
+            offsets[0] = 0;
+            for (size_t i = 0; i < sizeof...(Fields); i++) {
+                offsets[i + 1] = core::utilities::calculateAligmentSize(offsets[i] + allocator->alignSize(sizes[i]), alignments[i + 1]);
+            }
+            return offsets;
+        }
+    };
+
+    /**
+     * @brief Vulkan buffer with a structure-of-arrays layout of {N} elements
+     *
+     * @tparam N Count of elements
+     * @tparam Fields Types of fields
+     */
+    template<size_t N, class... Fields>
+    class SoaBuffer : public SoaArray<Fields...> {
+       public:
+        /**
+         * @brief Construct a new SoaBuffer object
+         *
+         * @param allocator Allocator
+         * @param usage Buffer usage
+         */
+        SoaBuffer(std::shared_ptr<Allocator> allocator, vk::BufferUsageFlags usage = vk::BufferUsageFlags())
+            : SoaArray<Fields...>(N, allocator, usage) {}
+
+        /**
+         * @brief Destroy the SoaBuffer object
+         *
+         */
+        virtual ~SoaBuffer() = default;
+    };
+}  // namespace ao::vulkan
@@ -4,8 +4,12 @@
 
 #include "device.h"
 
+#include <bitset>
+#include <cstring>
+
 #include "../utilities/vulkan.h"
 #include "fence.h"
+#include "timeline_semaphore.h"
 
 ao::vulkan::Device::Device(vk::PhysicalDevice device) : physical_(device) {}
 
@@ -16,7 +20,7 @@ ao::vulkan::Device::~Device() {
 
 void ao::vulkan::Device::initLogicalDevice(vk::ArrayProxy<char const* const> device_extensions,
                                            vk::ArrayProxy<vk::PhysicalDeviceFeatures const> device_features,
-                                           vk::ArrayProxy<QueueRequest const> requested_queues) {
+                                           vk::ArrayProxy<QueueRequest const> requested_queues, bool optional_extensions) {
     // Get queue families
     std::vector<vk::QueueFamilyProperties> queue_families = this->physical_.getQueueFamilyProperties();
 
@@ -69,11 +73,48 @@ void ao::vulkan::Device::initLogicalDevice(vk::ArrayProxy<char const* const> dev
     vk::DeviceCreateInfo device_info(vk::DeviceCreateFlags(), static_cast<u32>(queue_create_info.size()), queue_create_info.data());
     device_info.setPEnabledFeatures(device_features.data());
 
+    // Add optional extensions supported by device (memory budget needs Vulkan 1.1's getMemoryProperties2)
+    std::vector<char const*> extensions(device_extensions.begin(), device_extensions.end());
+    if (optional_extensions && this->physical_.getProperties().apiVersion >= VK_API_VERSION_1_1) {
+        auto properties = this->physical_.enumerateDeviceExtensionProperties();
+
+        for (char const* extension : {VK_EXT_MEMORY_BUDGET_EXTENSION_NAME}) {
+            bool supported = std::any_of(properties.begin(), properties.end(), [extension](vk::ExtensionProperties const& property) {
+                return std::strcmp(property.extensionName, extension) == 0;
+            });
+            bool requested =
+                std::any_of(extensions.begin(), extensions.end(), [extension](char const* name) { return std::strcmp(name, extension) == 0; });
+
+            if (supported && !requested) {
+                extensions.push_back(extension);
+            }
+        }
+    }
+
     // Add extensions
-    if (!device_extensions.empty()) {
-        device_info.setEnabledExtensionCount(static_cast<u32>(device_extensions.size()));
-        device_info.setPpEnabledExtensionNames(device_extensions.data());
+    if (!extensions.empty()) {
+        device_info.setEnabledExtensionCount(static_cast<u32>(extensions.size()));
+        device_info.setPpEnabledExtensionNames(extensions.data());
     }
+    this->extensions = std::set<std::string>(extensions.begin(), extensions.end());
+
+    // Enable timeline semaphores with their extension
+    ao::vulkan::timeline::PhysicalDeviceFeatures timeline_features;
+    timeline_features.timelineSemaphore = VK_TRUE;
+    if (this->extensionEnabled(ao::vulkan::timeline::ExtensionName)) {
+        device_info.setPNext(&timeline_features);
+    }
+
+    // Cache memory properties
+    this->memory_properties = this->physical_.getMemoryProperties();
+    auto device_type = this->physical_.getProperties().deviceType;
+    this->unified_memory =
+        (device_type == vk::PhysicalDeviceType::eIntegratedGpu || device_type == vk::PhysicalDeviceType::eCpu) &&
+        std::any_of(this->memory_properties.memoryTypes, this->memory_properties.memoryTypes + this->memory_properties.memoryTypeCount,
+                    [](vk::MemoryType const& type) {
+                        return (type.propertyFlags & (vk::MemoryPropertyFlagBits::eDeviceLocal | vk::MemoryPropertyFlagBits::eHostVisible)) ==
+                               (vk::MemoryPropertyFlagBits::eDeviceLocal | vk::MemoryPropertyFlagBits::eHostVisible);
+                    });
 
     // Create device
     this->logical_ = std::make_shared<vk::Device>(this->physical_.createDevice(device_info));
@@ -95,6 +136,29 @@ void ao::vulkan::Device::initLogicalDevice(vk::ArrayProxy<char const* const> dev
     }
 }
 
+u32 ao::vulkan::Device::memoryType(u32 memory_type_bits, vk::MemoryPropertyFlags required, vk::MemoryPropertyFlags preferred) const {
+    std::optional<std::pair<u32, size_t>> best;
+
+    // Rank types by count of preferred flags, first type wins on tie
+    for (u32 i = 0; i < this->memory_properties.memoryTypeCount; i++) {
+        auto flags = this->memory_properties.memoryTypes[i].propertyFlags;
+
+        if ((memory_type_bits & (1 << i)) && (flags & required) == required) {
+            size_t score = std::bitset<32>(static_cast<VkMemoryPropertyFlags>(flags & preferred)).count();
+
+            if (!best || score > best->second) {
+                best = std::make_pair(i, score);
+            }
+        }
+    }
+
+    // Check type
+    if (!best) {
+        throw ao::core::Exception(fmt::format("Fail to find a memory type with flags: {}", vk::to_string(required)));
+    }
+    return best->first;
+}
+
 ao::vulkan::CommandPool& ao::vulkan::Device::transferPool() {
     if (!this->transfer_command_pool) {
         throw ao::core::Exception("Transfer command pool is disabled, request a transfer queue to enable it");
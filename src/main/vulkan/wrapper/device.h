@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <set>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -49,9 +50,10 @@ namespace ao::vulkan {
          * @param device_extensions Device's extensions to enable
          * @param device_features Device's features to enable
          * @param requested_queues Requested queues
+         * @param optional_extensions Also enable optional extensions supported by device (VK_EXT_memory_budget)
          */
         void initLogicalDevice(vk::ArrayProxy<char const* const> device_extensions, vk::ArrayProxy<vk::PhysicalDeviceFeatures const> device_features,
-                               vk::ArrayProxy<QueueRequest const> requested_queues);
+                               vk::ArrayProxy<QueueRequest const> requested_queues, bool optional_extensions = true);
 
         /**
          * @brief Surface formats
@@ -73,6 +75,46 @@ namespace ao::vulkan {
             return this->logical_->getSwapchainImagesKHR(swapchain);
         }
 
+        /**
+         * @brief Device extension is enabled
+         *
+         * @param extension Extension's name
+         * @return true Extension is enabled
+         * @return false Extension isn't enabled
+         */
+        bool extensionEnabled(std::string const& extension) const {
+            return this->extensions.count(extension) != 0;
+        }
+
+        /**
+         * @brief Get memory properties (computed once by initLogicalDevice())
+         *
+         * @return vk::PhysicalDeviceMemoryProperties const& Properties
+         */
+        vk::PhysicalDeviceMemoryProperties const& memoryProperties() const {
+            return this->memory_properties;
+        }
+
+        /**
+         * @brief Find memory type that has {required} flags and as many {preferred} flags as possible
+         *
+         * @param memory_type_bits Type bits
+         * @param required Required flags
+         * @param preferred Preferred flags
+         * @return u32 Index
+         */
+        u32 memoryType(u32 memory_type_bits, vk::MemoryPropertyFlags required, vk::MemoryPropertyFlags preferred = vk::MemoryPropertyFlags()) const;
+
+        /**
+         * @brief Device shares its memory with host (integrated GPU or CPU implementation with host-visible device-local memory)
+         *
+         * @return true Memory is unified
+         * @return false Memory isn't unified
+         */
+        bool unifiedMemory() const {
+            return this->unified_memory;
+        }
+
         /**
          * @brief Get transfer command pool
          *
@@ -113,8 +155,12 @@ namespace ao::vulkan {
         std::unique_ptr<CommandPool> transfer_command_pool;
         std::unique_ptr<CommandPool> graphics_command_pool;
         std::unique_ptr<QueueContainer> queues_;
+        std::set<std::string> extensions;
 
         std::shared_ptr<vk::Device> logical_;
         vk::PhysicalDevice physical_;
+
+        vk::PhysicalDeviceMemoryProperties memory_properties;
+        bool unified_memory = false;
     };
 }  // namespace ao::vulkan
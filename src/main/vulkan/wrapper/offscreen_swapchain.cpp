@@ -0,0 +1,141 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include "offscreen_swapchain.h"
+
+#include <cstring>
+
+#include <ao/core/logging/log.h>
+
+#include "../utilities/device.h"
+
+ao::vulkan::OffscreenSwapchain::OffscreenSwapchain(std::shared_ptr<vk::Instance> instance, std::shared_ptr<Device> device, u32 images)
+    : ao::vulkan::Swapchain(instance, device) {
+    // Check images
+    if (images == 0) {
+        throw ao::core::Exception("OffscreenSwapchain needs at least one image");
+    }
+
+    this->surface_images_count = images;
+    this->frame_index = images - 1;  // First acquisition returns image 0
+}
+
+ao::vulkan::OffscreenSwapchain::~OffscreenSwapchain() {
+    this->destroyImages();
+}
+
+void ao::vulkan::OffscreenSwapchain::init(u32& surface_width, u32& surface_height, [[maybe_unused]] bool vsync, bool stencil_buffer) {
+    bool first_init = this->buffers.empty();
+
+    // Free old images
+    if (!first_init) {
+        this->destroyImages();
+        this->state_ = ao::vulkan::SwapchainState::eReset;
+    }
+    this->extent_ = vk::Extent2D(surface_width, surface_height);
+
+    // Create images
+    for (u32 i = 0; i < this->surface_images_count; i++) {
+        auto image = ao::vulkan::utilities::createImage(*this->device->logical(), this->device->memoryProperties(), this->extent_.width,
+                                                        this->extent_.height, 1, 1, ao::vulkan::OffscreenSwapchain::ColorFormat, vk::ImageType::e2D,
+                                                        vk::ImageTiling::eOptimal,
+                                                        vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc,
+                                                        vk::MemoryPropertyFlagBits::eDeviceLocal);
+        vk::ImageView view =
+            ao::vulkan::utilities::createImageView(*this->device->logical(), image.first, ao::vulkan::OffscreenSwapchain::ColorFormat,
+                                                   vk::ImageViewType::e2D, vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1));
+
+        this->buffers.push_back(std::make_pair(image.first, view));
+        this->memories.push_back(image.second);
+    }
+
+    LOG_MSG(debug) << fmt::format("Set-up an offscreen swap chain of {0} image{1}", this->buffers.size(), this->buffers.size() > 1 ? "s" : "");
+
+    // Create stencil buffer
+    if (stencil_buffer) {
+        // Destroy old one
+        if (this->stencil_buffer) {
+            this->destroyStencilBuffer();
+        }
+
+        this->createStencilBuffer();
+    }
+
+    if (first_init) {
+        this->createCommandBuffers();
+    }
+}
+
+void ao::vulkan::OffscreenSwapchain::initSurface() {
+    this->surface_color_format = ao::vulkan::OffscreenSwapchain::ColorFormat;
+    this->surface_color_space = vk::ColorSpaceKHR::eSrgbNonlinear;
+
+    // Images are released on graphics queue
+    this->present_queue = this->device->queues()->at(vk::to_string(vk::QueueFlagBits::eGraphics)).value;
+}
+
+vk::Result ao::vulkan::OffscreenSwapchain::acquireNextImage(vk::Semaphore acquire) {
+    this->state_ = ao::vulkan::SwapchainState::eAcquireImage;
+    this->frame_index = (this->frame_index + 1) % static_cast<u32>(this->buffers.size());
+
+    // Signal semaphore
+    if (acquire) {
+        this->present_queue.submit(vk::SubmitInfo(0, nullptr, nullptr, 0, nullptr, 1, &acquire), vk::Fence());
+    }
+    return vk::Result::eSuccess;
+}
+
+vk::Result ao::vulkan::OffscreenSwapchain::enqueueImage(vk::ArrayProxy<vk::Semaphore> waiting_semaphores) {
+    this->state_ = ao::vulkan::SwapchainState::eEnqueueImage;
+
+    // Consume semaphores
+    if (!waiting_semaphores.empty()) {
+        std::vector<vk::PipelineStageFlags> stages(waiting_semaphores.size(), vk::PipelineStageFlagBits::eAllCommands);
+
+        this->present_queue.submit(vk::SubmitInfo(waiting_semaphores.size(), waiting_semaphores.data(), stages.data()), vk::Fence());
+    }
+    return vk::Result::eSuccess;
+}
+
+std::vector<u8> ao::vulkan::OffscreenSwapchain::read(u32 index) const {
+    vk::DeviceSize size = static_cast<vk::DeviceSize>(this->extent_.width) * this->extent_.height * 4;
+
+    // Create host buffer
+    auto buffer =
+        this->device->logical()->createBuffer(vk::BufferCreateInfo(vk::BufferCreateFlags(), size, vk::BufferUsageFlagBits::eTransferDst));
+    auto mem_requirements = this->device->logical()->getBufferMemoryRequirements(buffer);
+    auto memory_type = this->device->memoryType(mem_requirements.memoryTypeBits,
+                                                vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+                                                vk::MemoryPropertyFlagBits::eHostCached);
+    auto memory = this->device->logical()->allocateMemory(vk::MemoryAllocateInfo(mem_requirements.size, memory_type));
+    this->device->logical()->bindBufferMemory(buffer, memory, 0);
+
+    // Copy image
+    ao::vulkan::utilities::copyImageToBuffer(
+        *this->device->logical(), this->device->graphicsPool(), *this->device->queues(), this->buffers.at(index).first,
+        ao::vulkan::OffscreenSwapchain::FinalLayout, buffer,
+        vk::BufferImageCopy(0, 0, 0, vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, 0, 0, 1), vk::Offset3D(),
+                            vk::Extent3D(this->extent_, 1)));
+
+    // Read pixels
+    std::vector<u8> pixels(size);
+    std::memcpy(pixels.data(), this->device->logical()->mapMemory(memory, 0, size), size);
+    this->device->logical()->unmapMemory(memory);
+
+    // Free buffer
+    this->device->logical()->destroyBuffer(buffer);
+    this->device->logical()->freeMemory(memory);
+
+    return pixels;
+}
+
+void ao::vulkan::OffscreenSwapchain::destroyImages() {
+    for (size_t i = 0; i < this->buffers.size(); i++) {
+        this->device->logical()->destroyImageView(this->buffers[i].second);
+        this->device->logical()->destroyImage(this->buffers[i].first);
+        this->device->logical()->freeMemory(this->memories[i]);
+    }
+    this->buffers.clear();
+    this->memories.clear();
+}
@@ -16,8 +16,12 @@ ao::vulkan::Swapchain::~Swapchain() {
         this->device->logical()->destroyImageView(buffer.second);
     }
 
-    this->device->logical()->destroySwapchainKHR(this->swapchain);
-    this->instance->destroySurfaceKHR(this->surface);
+    if (this->swapchain) {
+        this->device->logical()->destroySwapchainKHR(this->swapchain);
+    }
+    if (this->surface) {
+        this->instance->destroySurfaceKHR(this->surface);
+    }
 
     this->command_pool.reset();
 
@@ -165,16 +169,20 @@ void ao::vulkan::Swapchain::init(u32& surface_width, u32& surface_height, bool v
     }
 
     if (first_init) {
-        // Create command pool
-        this->command_pool =
-            std::make_unique<ao::vulkan::CommandPool>(this->device->logical(), vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
-                                                      this->device->queues()->at(vk::to_string(vk::QueueFlagBits::eGraphics)).family_index);
-
-        // Create commands
-        this->commands = this->command_pool->allocateCommandBuffers(vk::CommandBufferLevel::ePrimary, static_cast<u32>(this->buffers.size()));
+        this->createCommandBuffers();
     }
 }
 
+void ao::vulkan::Swapchain::createCommandBuffers() {
+    // Create command pool
+    this->command_pool =
+        std::make_unique<ao::vulkan::CommandPool>(this->device->logical(), vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
+                                                  this->device->queues()->at(vk::to_string(vk::QueueFlagBits::eGraphics)).family_index);
+
+    // Create commands
+    this->commands = this->command_pool->allocateCommandBuffers(vk::CommandBufferLevel::ePrimary, static_cast<u32>(this->buffers.size()));
+}
+
 void ao::vulkan::Swapchain::initSurface() {
     // Detect if a queue supports present
     std::vector<vk::Bool32> support_present(this->device->physical().getQueueFamilyProperties().size());
@@ -254,8 +262,8 @@ void ao::vulkan::Swapchain::createStencilBuffer() {
     auto depth_format = ao::vulkan::utilities::bestDepthStencilFormat(this->device->physical());
 
     // Create image and it's view
-    auto image = ao::vulkan::utilities::createImage(*this->device->logical(), this->device->physical(), this->extent_.width, this->extent_.height, 1,
-                                                    1, depth_format, vk::ImageType::e2D, vk::ImageTiling::eOptimal,
+    auto image = ao::vulkan::utilities::createImage(*this->device->logical(), this->device->memoryProperties(), this->extent_.width,
+                                                    this->extent_.height, 1, 1, depth_format, vk::ImageType::e2D, vk::ImageTiling::eOptimal,
                                                     vk::ImageUsageFlagBits::eDepthStencilAttachment, vk::MemoryPropertyFlagBits::eDeviceLocal);
     vk::ImageView view = ao::vulkan::utilities::createImageView(*this->device->logical(), image.first, depth_format, vk::ImageViewType::e2D,
                                                                 vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eDepth, 0, 1, 0, 1));
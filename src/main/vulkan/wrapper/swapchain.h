@@ -51,13 +51,13 @@ namespace ao::vulkan {
          * @param vsync Enable vsync
          * @param stencil_buffer Enable stencil buffer
          */
-        void init(u32& surface_width, u32& surface_height, bool vsync, bool stencil_buffer);
+        virtual void init(u32& surface_width, u32& surface_height, bool vsync, bool stencil_buffer);
 
         /**
          * @brief Initialize surface
          *
          */
-        void initSurface();
+        virtual void initSurface();
 
         /**
          * @brief Create framebuffers
@@ -171,7 +171,7 @@ namespace ao::vulkan {
          * @param acquire Acquire semaphore
          * @return vk::Result Result
          */
-        vk::Result acquireNextImage(vk::Semaphore acquire);
+        virtual vk::Result acquireNextImage(vk::Semaphore acquire);
 
         /**
          * @brief Enqueue an image
@@ -179,7 +179,7 @@ namespace ao::vulkan {
          * @param waiting_semaphores Waiting semaphores
          * @return vk::Result Result
          */
-        vk::Result enqueueImage(vk::ArrayProxy<vk::Semaphore> waiting_semaphores);
+        virtual vk::Result enqueueImage(vk::ArrayProxy<vk::Semaphore> waiting_semaphores);
 
         /**
          * @brief Set surface
@@ -209,5 +209,11 @@ namespace ao::vulkan {
         std::vector<vk::CommandBuffer> commands;
         std::shared_ptr<vk::Instance> instance;
         std::shared_ptr<Device> device;
+
+        /**
+         * @brief Create command pool and a command buffer per image
+         *
+         */
+        void createCommandBuffers();
     };
 }  // namespace ao::vulkan
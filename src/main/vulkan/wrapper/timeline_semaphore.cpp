@@ -0,0 +1,109 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include "timeline_semaphore.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "../utilities/vulkan.h"
+
+bool ao::vulkan::timelineSemaphoreSupported(vk::PhysicalDevice device) {
+    // Features are queried through Vulkan 1.1's getFeatures2
+    if (device.getProperties().apiVersion < VK_API_VERSION_1_1) {
+        return false;
+    }
+
+    // Check extension
+    auto extensions = device.enumerateDeviceExtensionProperties();
+    if (std::none_of(extensions.begin(), extensions.end(), [](vk::ExtensionProperties const& extension) {
+            return std::strcmp(extension.extensionName, ao::vulkan::timeline::ExtensionName) == 0;
+        })) {
+        return false;
+    }
+
+    // Check feature
+    ao::vulkan::timeline::PhysicalDeviceFeatures timeline_features;
+    VkPhysicalDeviceFeatures2 features = {};
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features.pNext = &timeline_features;
+    vkGetPhysicalDeviceFeatures2(device, &features);
+
+    return timeline_features.timelineSemaphore == VK_TRUE;
+}
+
+ao::vulkan::TimelineSemaphore::TimelineSemaphore(std::shared_ptr<vk::Device> device, u64 initial_value) : device(device), target_(initial_value) {
+    // Load functions (vendored loader doesn't know them)
+    this->get_counter_value = reinterpret_cast<ao::vulkan::timeline::GetSemaphoreCounterValue>(
+        vkGetDeviceProcAddr(*this->device, "vkGetSemaphoreCounterValueKHR"));
+    this->wait_semaphores = reinterpret_cast<ao::vulkan::timeline::WaitSemaphores>(vkGetDeviceProcAddr(*this->device, "vkWaitSemaphoresKHR"));
+    this->signal_semaphore = reinterpret_cast<ao::vulkan::timeline::SignalSemaphore>(vkGetDeviceProcAddr(*this->device, "vkSignalSemaphoreKHR"));
+    if (!this->get_counter_value || !this->wait_semaphores || !this->signal_semaphore) {
+        throw ao::core::Exception(fmt::format("{} isn't enabled", ao::vulkan::timeline::ExtensionName));
+    }
+
+    // Create semaphore
+    ao::vulkan::timeline::SemaphoreTypeCreateInfo type_info;
+    type_info.initialValue = initial_value;
+    this->semaphore = this->device->createSemaphore(vk::SemaphoreCreateInfo().setPNext(&type_info));
+}
+
+ao::vulkan::TimelineSemaphore::~TimelineSemaphore() {
+    this->device->destroySemaphore(this->semaphore);
+}
+
+u64 ao::vulkan::TimelineSemaphore::value() const {
+    u64 value = 0;
+
+    ao::vulkan::utilities::vkAssert(this->get_counter_value(*this->device, this->semaphore, &value), "Fail to get semaphore's value");
+    return value;
+}
+
+bool ao::vulkan::TimelineSemaphore::wait(u64 value, u64 timeout) const {
+    VkSemaphore semaphore = this->semaphore;
+    ao::vulkan::timeline::SemaphoreWaitInfo wait_info;
+    wait_info.semaphoreCount = 1;
+    wait_info.pSemaphores = &semaphore;
+    wait_info.pValues = &value;
+
+    // Wait value
+    VkResult result = this->wait_semaphores(*this->device, &wait_info, timeout);
+    if (result == VK_TIMEOUT) {
+        return false;
+    }
+    ao::vulkan::utilities::vkAssert(result, "Fail to wait semaphore");
+    return true;
+}
+
+void ao::vulkan::TimelineSemaphore::signal(u64 value) {
+    ao::vulkan::timeline::SemaphoreSignalInfo signal_info;
+    signal_info.semaphore = this->semaphore;
+    signal_info.value = value;
+
+    ao::vulkan::utilities::vkAssert(this->signal_semaphore(*this->device, &signal_info), "Fail to signal semaphore");
+    this->target_ = std::max(this->target_, value);
+}
+
+void ao::vulkan::TimelineSemaphore::submit(vk::Queue queue, vk::SubmitInfo submit_info, u64 value) const {
+    std::vector<vk::Semaphore> signals(submit_info.pSignalSemaphores, submit_info.pSignalSemaphores + submit_info.signalSemaphoreCount);
+    std::vector<u64> wait_values(submit_info.waitSemaphoreCount, 0);
+
+    // Signal value, binary semaphores ignore their values
+    signals.push_back(this->semaphore);
+    std::vector<u64> signal_values(signals.size(), 0);
+    signal_values.back() = value;
+
+    ao::vulkan::timeline::SubmitInfo timeline_info;
+    timeline_info.pNext = submit_info.pNext;
+    timeline_info.waitSemaphoreValueCount = static_cast<u32>(wait_values.size());
+    timeline_info.pWaitSemaphoreValues = wait_values.data();
+    timeline_info.signalSemaphoreValueCount = static_cast<u32>(signal_values.size());
+    timeline_info.pSignalSemaphoreValues = signal_values.data();
+    submit_info.setPNext(&timeline_info);
+    submit_info.setSignalSemaphoreCount(static_cast<u32>(signals.size()));
+    submit_info.setPSignalSemaphores(signals.data());
+
+    queue.submit(submit_info, vk::Fence());
+}
@@ -0,0 +1,194 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#pragma once
+
+#include <limits>
+#include <memory>
+
+#include <ao/core/utilities/types.h>
+#include <vulkan/vulkan.hpp>
+
+namespace ao::vulkan {
+    /**
+     * @brief Declarations of VK_KHR_timeline_semaphore (Vulkan 1.1.121), vendored Vulkan headers (1.1.97) predate it.
+     * Values and layouts are the registry's ones, so they stay valid once headers declare the extension
+     *
+     */
+    namespace timeline {
+        static constexpr char const* ExtensionName = "VK_KHR_timeline_semaphore";
+
+        static constexpr VkStructureType PhysicalDeviceFeaturesType = static_cast<VkStructureType>(1000207000);
+        static constexpr VkStructureType SemaphoreTypeCreateInfoType = static_cast<VkStructureType>(1000207002);
+        static constexpr VkStructureType SubmitInfoType = static_cast<VkStructureType>(1000207003);
+        static constexpr VkStructureType SemaphoreWaitInfoType = static_cast<VkStructureType>(1000207004);
+        static constexpr VkStructureType SemaphoreSignalInfoType = static_cast<VkStructureType>(1000207005);
+        static constexpr u32 SemaphoreTypeTimeline = 1;
+
+        /**
+         * @brief VkPhysicalDeviceTimelineSemaphoreFeaturesKHR
+         *
+         */
+        struct PhysicalDeviceFeatures {
+            VkStructureType sType = PhysicalDeviceFeaturesType;
+            void* pNext = nullptr;
+            VkBool32 timelineSemaphore = VK_FALSE;
+        };
+
+        /**
+         * @brief VkSemaphoreTypeCreateInfoKHR
+         *
+         */
+        struct SemaphoreTypeCreateInfo {
+            VkStructureType sType = SemaphoreTypeCreateInfoType;
+            void const* pNext = nullptr;
+            u32 semaphoreType = SemaphoreTypeTimeline;
+            u64 initialValue = 0;
+        };
+
+        /**
+         * @brief VkTimelineSemaphoreSubmitInfoKHR
+         *
+         */
+        struct SubmitInfo {
+            VkStructureType sType = SubmitInfoType;
+            void const* pNext = nullptr;
+            u32 waitSemaphoreValueCount = 0;
+            u64 const* pWaitSemaphoreValues = nullptr;
+            u32 signalSemaphoreValueCount = 0;
+            u64 const* pSignalSemaphoreValues = nullptr;
+        };
+
+        /**
+         * @brief VkSemaphoreWaitInfoKHR
+         *
+         */
+        struct SemaphoreWaitInfo {
+            VkStructureType sType = SemaphoreWaitInfoType;
+            void const* pNext = nullptr;
+            VkFlags flags = 0;
+            u32 semaphoreCount = 0;
+            VkSemaphore const* pSemaphores = nullptr;
+            u64 const* pValues = nullptr;
+        };
+
+        /**
+         * @brief VkSemaphoreSignalInfoKHR
+         *
+         */
+        struct SemaphoreSignalInfo {
+            VkStructureType sType = SemaphoreSignalInfoType;
+            void const* pNext = nullptr;
+            VkSemaphore semaphore = VK_NULL_HANDLE;
+            u64 value = 0;
+        };
+
+        using GetSemaphoreCounterValue = VkResult(VKAPI_PTR*)(VkDevice device, VkSemaphore semaphore, u64* value);
+        using WaitSemaphores = VkResult(VKAPI_PTR*)(VkDevice device, SemaphoreWaitInfo const* wait_info, u64 timeout);
+        using SignalSemaphore = VkResult(VKAPI_PTR*)(VkDevice device, SemaphoreSignalInfo const* signal_info);
+    }  // namespace timeline
+
+    /**
+     * @brief Check if timeline semaphores are supported by device (VK_KHR_timeline_semaphore extension and feature)
+     *
+     * @param device Device
+     * @return true Timeline semaphores are supported
+     * @return false Timeline semaphores aren't supported
+     */
+    bool timelineSemaphoreSupported(vk::PhysicalDevice device);
+
+    /**
+     * @brief Timeline vk::Semaphore wrapper: a monotonically increasing counter, submissions signal/wait values
+     * and host waits a value, so a single semaphore replaces a fence per frame and cross-queue semaphores
+     *
+     */
+    class TimelineSemaphore {
+       public:
+        /**
+         * @brief Construct a new TimelineSemaphore object, device must enable VK_KHR_timeline_semaphore
+         *
+         * @param device Device
+         * @param initial_value Initial value
+         */
+        explicit TimelineSemaphore(std::shared_ptr<vk::Device> device, u64 initial_value = 0);
+        TimelineSemaphore(TimelineSemaphore const&) = delete;
+
+        /**
+         * @brief Destroy the TimelineSemaphore object
+         *
+         */
+        virtual ~TimelineSemaphore();
+
+        /**
+         * @brief Get current value (last value signaled on device or host)
+         *
+         * @return u64 Value
+         */
+        u64 value() const;
+
+        /**
+         * @brief Get last value handed out by next()
+         *
+         * @return u64 Value
+         */
+        u64 target() const {
+            return this->target_;
+        }
+
+        /**
+         * @brief Get next value to signal
+         *
+         * @return u64 Value
+         */
+        u64 next() {
+            return ++this->target_;
+        }
+
+        /**
+         * @brief Wait until semaphore reaches {value}
+         *
+         * @param value Value
+         * @param timeout Timeout
+         * @return true Value is reached
+         * @return false Timeout expired
+         */
+        bool wait(u64 value, u64 timeout = (std::numeric_limits<u64>::max)()) const;
+
+        /**
+         * @brief Signal {value} from host, next() continues after it
+         *
+         * @param value Value
+         */
+        void signal(u64 value);
+
+        /**
+         * @brief Submit {submit_info} to {queue}, its binary semaphores are kept and semaphore signals {value} once it's executed
+         *
+         * @param queue Queue
+         * @param submit_info Submit info
+         * @param value Value
+         */
+        void submit(vk::Queue queue, vk::SubmitInfo submit_info, u64 value) const;
+
+        /**
+         * @brief Implicit conversion into vk::Semaphore
+         *
+         * @return vk::Semaphore Semaphore
+         */
+        operator vk::Semaphore() const {
+            return this->semaphore;
+        }
+
+        TimelineSemaphore& operator=(TimelineSemaphore const&) = delete;
+
+       protected:
+        std::shared_ptr<vk::Device> device;
+        vk::Semaphore semaphore;
+        u64 target_;
+
+        timeline::GetSemaphoreCounterValue get_counter_value;
+        timeline::WaitSemaphores wait_semaphores;
+        timeline::SignalSemaphore signal_semaphore;
+    };
+}  // namespace ao::vulkan
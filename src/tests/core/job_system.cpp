@@ -0,0 +1,75 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include <gtest/gtest.h>
+#include <ao/core/thread/job_system.h>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace ao::test {
+    TEST(JobSystem, ParallelFor) {
+        core::JobSystem jobs(3);
+        std::vector<int> values(10000, 0);
+
+        jobs.parallelFor(0, values.size(), [&values](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                values[i] += static_cast<int>(i);
+            }
+        });
+
+        // Assert each index is visited once
+        for (size_t i = 0; i < values.size(); i++) {
+            ASSERT_EQ(static_cast<int>(i), values[i]);
+        }
+    }
+
+    TEST(JobSystem, Dependencies) {
+        core::JobSystem jobs(2);
+        std::atomic<int> first(0);
+        std::atomic<bool> ordered(true);
+
+        // Jobs of second counter start once first counter is done
+        auto counter = std::make_shared<core::JobCounter>();
+        for (int i = 0; i < 100; i++) {
+            jobs.schedule([&first]() { first++; }, counter);
+        }
+        auto dependent = jobs.schedule([&first, &ordered]() { ordered = ordered && first == 100; }, nullptr, counter);
+        jobs.schedule([&first, &ordered]() { ordered = ordered && first == 100; }, dependent, counter);
+
+        jobs.wait(dependent);
+
+        // Assert
+        ASSERT_TRUE(counter->done());
+        ASSERT_TRUE(dependent->done());
+        ASSERT_TRUE(ordered);
+    }
+
+    TEST(JobSystem, Nested) {
+        core::JobSystem jobs(2);
+        std::atomic<size_t> count(0);
+
+        // Jobs waiting other jobs don't deadlock workers
+        jobs.parallelFor(
+            0, 16,
+            [&jobs, &count]([[maybe_unused]] size_t begin, [[maybe_unused]] size_t end) {
+                jobs.parallelFor(0, 100, [&count](size_t begin, size_t end) { count += end - begin; });
+            },
+            1);
+
+        ASSERT_EQ(16 * 100, count);
+    }
+
+    TEST(JobSystem, Exception) {
+        core::JobSystem jobs(2);
+
+        auto counter = jobs.schedule([]() { throw std::runtime_error("Job failure"); });
+        ASSERT_THROW(jobs.wait(counter), std::runtime_error);
+        ASSERT_NO_THROW(jobs.wait(counter));
+
+        ASSERT_THROW(jobs.parallelFor(0, 10,
+                                      []([[maybe_unused]] size_t begin, [[maybe_unused]] size_t end) { throw std::runtime_error("Job failure"); }),
+                     std::runtime_error);
+    }
+}  // namespace ao::test
@@ -0,0 +1,82 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include <ao/core/utilities/memory.h>
+#include <ao/core/utilities/types.h>
+#include <gtest/gtest.h>
+#include <map>
+#include <vector>
+
+namespace ao::test {
+    using Ranges = std::map<size_t, size_t>;
+
+    TEST(MergeRange, Disjoint) {
+        Ranges ranges;
+
+        core::utilities::mergeRange<size_t>(ranges, 10, 20);
+        core::utilities::mergeRange<size_t>(ranges, 30, 40);
+        core::utilities::mergeRange<size_t>(ranges, 0, 5);
+
+        // Assert
+        ASSERT_EQ((Ranges{{0, 5}, {10, 20}, {30, 40}}), ranges);
+    }
+
+    TEST(MergeRange, Adjacent) {
+        Ranges ranges;
+
+        core::utilities::mergeRange<size_t>(ranges, 10, 20);
+        core::utilities::mergeRange<size_t>(ranges, 20, 30);
+        core::utilities::mergeRange<size_t>(ranges, 0, 10);
+
+        // Assert
+        ASSERT_EQ((Ranges{{0, 30}}), ranges);
+    }
+
+    TEST(MergeRange, Overlapping) {
+        Ranges ranges;
+
+        core::utilities::mergeRange<size_t>(ranges, 10, 20);
+        core::utilities::mergeRange<size_t>(ranges, 15, 25);
+        core::utilities::mergeRange<size_t>(ranges, 5, 12);
+
+        // Assert
+        ASSERT_EQ((Ranges{{5, 25}}), ranges);
+
+        // Contained range
+        core::utilities::mergeRange<size_t>(ranges, 8, 9);
+        ASSERT_EQ((Ranges{{5, 25}}), ranges);
+    }
+
+    TEST(MergeRange, Spanning) {
+        Ranges ranges{{0, 5}, {10, 15}, {20, 25}, {40, 50}};
+
+        // Range covers several intervals
+        core::utilities::mergeRange<size_t>(ranges, 3, 22);
+
+        // Assert
+        ASSERT_EQ((Ranges{{0, 25}, {40, 50}}), ranges);
+    }
+
+    TEST(StridedCopy, Strided) {
+        std::vector<u32> source = {1, 2, 3};
+        std::vector<u32> destination(6, 0);
+
+        core::utilities::stridedCopy(destination.data(), 2 * sizeof(u32), source.data(), source.size());
+
+        // Assert
+        ASSERT_EQ((std::vector<u32>{1, 0, 2, 0, 3, 0}), destination);
+    }
+
+    TEST(StridedFill, Chunks) {
+        std::vector<u32> destination(3000, 0);
+
+        // Fill spans several chunks
+        core::utilities::stridedFill(destination.data(), 2 * sizeof(u32), u32(7), destination.size() / 2);
+
+        // Assert
+        for (size_t i = 0; i < destination.size(); i++) {
+            ASSERT_EQ(i % 2 == 0 ? 7 : 0, destination[i]);
+        }
+    }
+}  // namespace ao::test
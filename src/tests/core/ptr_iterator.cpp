@@ -0,0 +1,44 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <ao/core/memory/ptr_iterator.hpp>
+#include <iterator>
+#include <numeric>
+
+namespace ao::test {
+    struct Padded {
+        int value;
+        int padding;
+    };
+
+    TEST(PtrIterator, RandomAccess) {
+        int values[] = {5, 3, 4, 1, 2};
+        core::PtrIterator<int> begin(values), end(values + 5);
+
+        static_assert(std::is_same_v<std::iterator_traits<core::PtrIterator<int>>::iterator_category, std::random_access_iterator_tag>);
+
+        std::sort(begin, end);
+
+        ASSERT_EQ(5, end - begin);
+        ASSERT_EQ(3, begin[2]);
+        ASSERT_EQ(5, *(end - 1));
+        ASSERT_TRUE(begin < end);
+        ASSERT_TRUE(begin.contiguous());
+    }
+
+    TEST(PtrIterator, Stride) {
+        Padded values[] = {{3, 0}, {1, 0}, {2, 0}};
+        core::PtrIterator<int> begin(&values[0].value, sizeof(Padded)), end = begin + 3;
+
+        std::sort(begin, end);
+
+        ASSERT_FALSE(begin.contiguous());
+        ASSERT_EQ(3, std::distance(begin, end));
+        ASSERT_EQ(6, std::accumulate(begin, end, 0));
+        ASSERT_EQ(1, values[0].value);
+        ASSERT_EQ(3, values[2].value);
+    }
+}  // namespace ao::test
@@ -0,0 +1,105 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include <gtest/gtest.h>
+#include <ao/core/memory/slot_table.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace ao::test {
+    using Table = core::SlotTable<int, 16>;
+
+    TEST(SlotTable, InsertAndErase) {
+        Table table;
+
+        auto handle = table.insert(1);
+        ASSERT_TRUE(table.contains(handle));
+        ASSERT_EQ(1, *table.get(handle));
+        ASSERT_EQ(1, table.size());
+
+        ASSERT_TRUE(table.erase(handle));
+        ASSERT_FALSE(table.contains(handle));
+        ASSERT_EQ(nullptr, table.get(handle));
+        ASSERT_FALSE(table.erase(handle));
+        ASSERT_TRUE(table.empty());
+
+        ASSERT_FALSE(table.contains(Table::InvalidHandle));
+    }
+
+    TEST(SlotTable, StaleHandle) {
+        Table table, other;
+
+        // Slot is reused with another generation
+        auto handle = table.insert(1);
+        table.erase(handle);
+        auto new_handle = table.insert(2);
+
+        ASSERT_NE(handle, new_handle);
+        ASSERT_FALSE(table.contains(handle));
+        ASSERT_EQ(2, *table.get(new_handle));
+
+        // Handle isn't valid in another table
+        other.insert(3);
+        ASSERT_FALSE(other.contains(new_handle));
+    }
+
+    TEST(SlotTable, Threads) {
+        Table table;
+        std::vector<std::thread> threads;
+        std::vector<std::vector<Table::Handle>> handles(4);
+
+        for (size_t i = 0; i < handles.size(); i++) {
+            threads.emplace_back([&table, &handles, i]() {
+                for (int j = 0; j < 100; j++) {
+                    handles[i].push_back(table.insert(j));
+                }
+                for (size_t j = 0; j < handles[i].size(); j += 2) {
+                    table.erase(handles[i][j]);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        // Assert
+        ASSERT_EQ(200, table.size());
+        for (auto& thread_handles : handles) {
+            for (size_t j = 0; j < thread_handles.size(); j++) {
+                ASSERT_EQ(j % 2 != 0, table.contains(thread_handles[j]));
+            }
+        }
+
+        size_t count = 0;
+        table.forEach([&count]([[maybe_unused]] Table::Handle handle, [[maybe_unused]] int& value) { count++; });
+        ASSERT_EQ(200, count);
+    }
+
+    TEST(SlotTable, ConcurrentExtract) {
+        Table table;
+        std::atomic<int> extracted(0);
+
+        for (int i = 0; i < 100; i++) {
+            auto handle = table.insert(i);
+            std::vector<std::thread> threads;
+
+            // A single thread gets the value
+            for (size_t j = 0; j < 4; j++) {
+                threads.emplace_back([&table, &extracted, handle]() {
+                    if (table.extract(handle)) {
+                        extracted++;
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+
+        // Assert
+        ASSERT_EQ(100, extracted);
+        ASSERT_TRUE(table.empty());
+    }
+}  // namespace ao::test
@@ -20,10 +20,12 @@ namespace ao::test {
         /**
          * @brief Init vulkan
          *
+         * @param validation Enable validation layers
+         * @param optional_extensions Enable optional device extensions
          * @return true Vulkan initialized
          * @return false Fail to initialize vulkan
          */
-        bool init();
+        bool init(bool validation = true, bool optional_extensions = true);
 
         /**
          * @brief Get minimal alignment for a buffer
@@ -40,9 +42,9 @@ namespace ao::test {
         }
     }
 
-    bool VkInstance::init() {
+    bool VkInstance::init(bool validation, bool optional_extensions) {
         std::shared_ptr<vulkan::EngineSettings> settings = std::make_shared<vulkan::EngineSettings>();
-        settings->get<bool>(vulkan::settings::ValidationLayers) = true;
+        settings->get<bool>(vulkan::settings::ValidationLayers) = validation;
 
         try {
             // Init volk
@@ -67,7 +69,8 @@ namespace ao::test {
             this->device->initLogicalDevice(
                 {}, {},
                 {vulkan::QueueRequest(vk::QueueFlagBits::eGraphics), vulkan::QueueRequest(vk::QueueFlagBits::eTransfer, 0, 1),
-                 vulkan::QueueRequest(vk::QueueFlagBits::eCompute)});
+                 vulkan::QueueRequest(vk::QueueFlagBits::eCompute)},
+                optional_extensions);
         } catch (...) {
             return false;
         }
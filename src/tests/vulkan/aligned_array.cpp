@@ -0,0 +1,52 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include <ao/core/utilities/types.h>
+#include <ao/vulkan/memory/allocator/host_allocator.h>
+#include <gtest/gtest.h>
+#include <ao/vulkan/memory/aligned_array.hpp>
+#include <boost/log/core.hpp>
+#include <boost/log/expressions.hpp>
+#include <boost/log/trivial.hpp>
+
+#include "../helpers/tests.h"
+#include "../helpers/vk_instance.hpp"
+
+namespace ao::test {
+    TEST(AlignedArray, Stride) {
+        // 'Mute' logger
+        core::Logger::Init();
+        boost::log::core::get()->set_filter(boost::log::trivial::severity >= boost::log::trivial::fatal);
+
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<vulkan::HostAllocator>(instance.device);
+        vulkan::AlignedArray<10, u64, 64> array(15, allocator);
+
+        static_assert(vulkan::AlignedArray<10, u64, 64>::Stride == 64);
+        static_assert(vulkan::AlignedArray<10, u64, 64>::relativeOffset(3) == 192);
+        ASSERT_EQ(array.info().offset + 192, array.offset(3));
+
+        // Assert content
+        size_t count = 0;
+        for (auto& value : array) {
+            ASSERT_EQ(15, value);
+            count++;
+        }
+        ASSERT_EQ(10, count);
+    }
+
+    TEST(AlignedArray, IncompatibleAlignment) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<vulkan::HostAllocator>(instance.device, 256);
+
+        // Assert
+        ASSERT_THROW((vulkan::AlignedArray<10, u64, 8>(allocator)), core::Exception);
+    }
+}  // namespace ao::test
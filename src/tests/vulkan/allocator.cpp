@@ -2,9 +2,13 @@
 // Licensed under GPLv3 or any later version
 // Refer to the LICENSE.md file included.
 
+#include <algorithm>
+#include <numeric>
+
 #include <ao/core/utilities/memory.h>
 #include <ao/vulkan/memory/allocator/device_allocator.h>
 #include <ao/vulkan/memory/allocator/host_allocator.h>
+#include <ao/vulkan/memory/allocator/linear_allocator.h>
 #include <gtest/gtest.h>
 #include <boost/log/core.hpp>
 #include <boost/log/expressions.hpp>
@@ -43,7 +47,7 @@ namespace ao::test {
         auto info = allocator->allocate(sizeof(size_t), vk::BufferUsageFlagBits());
         ASSERT_NE(nullptr, info.buffer);
         ASSERT_TRUE(info.ptr);
-        ASSERT_EQ(ao::core::utilities::calculateAligmentSize(sizeof(size_t), instance.minAligment()), info.size);
+        ASSERT_EQ(sizeof(size_t), info.size);
     }
 
     TEST(HostAllocator, Free) {
@@ -145,29 +149,104 @@ namespace ao::test {
         // Init instance
         VkInstance instance;
         SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+        SKIP_TEST(instance.device->unifiedMemory(), UNIFIED_MEMORY);
 
         auto allocator = std::make_shared<vulkan::DeviceAllocator>(instance.device, vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
         auto info = allocator->allocate(sizeof(size_t), vk::BufferUsageFlagBits());
 
         // Assert
-        ASSERT_EQ(2 * info.size, allocator->size());
+        ASSERT_LE(info.size, allocator->sizeOnDevice());
+        ASSERT_EQ(2 * allocator->sizeOnDevice(), allocator->size());
+    }
+
+    TEST(HostAllocator, SubAllocate) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<vulkan::HostAllocator>(instance.device);
+        auto first = allocator->allocate(sizeof(size_t), vk::BufferUsageFlagBits::eUniformBuffer);
+        auto second = allocator->allocate(sizeof(size_t), vk::BufferUsageFlagBits::eUniformBuffer);
+
+        // Assert
+        ASSERT_EQ(1, allocator->blockCount());
+        ASSERT_EQ(first.buffer, second.buffer);
+        ASSERT_NE(first.offset, second.offset);
+        ASSERT_EQ(static_cast<char*>(*first.ptr) + (second.offset - first.offset), *second.ptr);
+
+        allocator->free(first);
+
+        // Assert
+        ASSERT_FALSE(allocator->own(first));
+        ASSERT_TRUE(allocator->own(second));
+    }
+
+    TEST(HostAllocator, BigAllocation) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<vulkan::HostAllocator>(instance.device, 0, 1024);
+        auto small = allocator->allocate(sizeof(size_t), vk::BufferUsageFlagBits::eUniformBuffer);
+        auto big = allocator->allocate(4096, vk::BufferUsageFlagBits::eUniformBuffer);
+
+        // Assert
+        ASSERT_EQ(2, allocator->blockCount());
+        ASSERT_NE(small.buffer, big.buffer);
+
+        allocator->free(big);
+
+        // Assert
+        ASSERT_EQ(1, allocator->blockCount());
+    }
+
+    TEST(DeviceAllocator, TLSF) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<vulkan::DeviceAllocator>(instance.device, vk::CommandBufferUsageFlagBits::eOneTimeSubmit, 0,
+                                                                   vulkan::DeviceAllocationStrategy::eTLSF);
+        auto first = allocator->allocate(sizeof(size_t), vk::BufferUsageFlagBits::eVertexBuffer);
+        auto second = allocator->allocate(sizeof(size_t), vk::BufferUsageFlagBits::eVertexBuffer);
+
+        // Assert
+        ASSERT_EQ(first.buffer, second.buffer);
+        ASSERT_NE(first.offset, second.offset);
+
+        // Update
+        *static_cast<size_t*>(*second.ptr) = 42;
+        allocator->invalidate(second, 0, sizeof(size_t));
+
+        // Assert range past allocation isn't copied into neighbouring ranges
+        ASSERT_EQ(sizeof(size_t), second.size);
+        ASSERT_THROW(allocator->invalidate(second, 0, second.size + 1), core::Exception);
+        ASSERT_THROW(allocator->invalidateRanges(second, {{0, sizeof(size_t)}, {4, second.size + 4}}), core::Exception);
+
+        allocator->free(first);
+
+        // Assert
+        ASSERT_FALSE(allocator->own(first));
+        ASSERT_TRUE(allocator->own(second));
     }
 
     TEST(DeviceAllocator, FreeHost) {
         // Init instance
         VkInstance instance;
         SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+        SKIP_TEST(instance.device->unifiedMemory(), UNIFIED_MEMORY);
 
         auto allocator = std::make_shared<vulkan::DeviceAllocator>(instance.device, vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
         auto info = allocator->allocate(sizeof(size_t), vk::BufferUsageFlagBits());
 
         // Assert size
-        ASSERT_EQ(2 * info.size, allocator->size());
+        auto device_size = allocator->sizeOnDevice();
+        ASSERT_EQ(2 * device_size, allocator->size());
 
         allocator->freeHost(info);
 
         // Assert
-        ASSERT_EQ(info.size, allocator->size());
+        ASSERT_EQ(device_size, allocator->size());
         ASSERT_TRUE(allocator->own(info));
     }
 
@@ -185,7 +264,390 @@ namespace ao::test {
         allocator->freeHost(info);
 
         // Assert
-        ASSERT_EQ(info.size, allocator->sizeOnDevice());
+        ASSERT_LE(info.size, allocator->sizeOnDevice());
+        ASSERT_EQ(allocator->sizeOnDevice(), allocator->size());
+        ASSERT_EQ(0, allocator->sizeOnHost());
+    }
+
+    TEST(DeviceAllocator, StagingRing) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+        SKIP_TEST(instance.device->unifiedMemory(), UNIFIED_MEMORY);
+
+        auto ring = std::make_shared<vulkan::StagingRing>(instance.device, 1024);
+        auto allocator = std::make_shared<vulkan::DeviceAllocator>(instance.device, vk::CommandBufferUsageFlagBits::eOneTimeSubmit, 0,
+                                                                   vulkan::DeviceAllocationStrategy::eDedicated,
+                                                                   vulkan::DeviceAllocator::DefaultBlockSize, ring);
+        auto info = allocator->allocate(4096, vk::BufferUsageFlagBits::eVertexBuffer);
+
+        // Assert host copy is counted
+        ASSERT_TRUE(info.ptr);
+        ASSERT_EQ(4096, allocator->sizeOnHost());
+        ASSERT_EQ(4096, allocator->statistics().host_copies);
+        ASSERT_NE(std::string::npos, allocator->dump().find("\"host_copies\": 4096"));
+
+        // Update (transfer is bigger than ring)
+        std::fill_n(static_cast<char*>(*info.ptr), 4096, 42);
+        ASSERT_NO_THROW(allocator->invalidate(info, 0, 4096));
+        ASSERT_LE(ring->used(), ring->size());
+
+        // Assert host copy is released
+        allocator->freeHost(info);
+        ASSERT_EQ(0, allocator->sizeOnHost());
+    }
+
+    TEST(DeviceAllocator, StagingRingExactFill) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+        SKIP_TEST(instance.device->unifiedMemory(), UNIFIED_MEMORY);
+
+        auto ring = std::make_shared<vulkan::StagingRing>(instance.device, 1024);
+        auto allocator = std::make_shared<vulkan::DeviceAllocator>(instance.device, vk::CommandBufferUsageFlagBits::eOneTimeSubmit, 0,
+                                                                   vulkan::DeviceAllocationStrategy::eTLSF,
+                                                                   vulkan::DeviceAllocator::DefaultBlockSize, ring);
+        auto first = allocator->allocate(ring->size(), vk::BufferUsageFlagBits::eVertexBuffer);
+        auto second = allocator->allocate(ring->size(), vk::BufferUsageFlagBits::eVertexBuffer);
+        allocator->setTransferMode(vulkan::TransferMode::eDeferred);
+
+        // First allocation fills ring's region exactly, so second one starts with a new region
+        allocator->invalidate(first, 0, first.size);
+        allocator->invalidate(second, 0, second.size);
+
+        // Assert
+        auto fence = allocator->flush();
+        ASSERT_TRUE(fence);
+        fence.wait();
+        ASSERT_LE(ring->used(), ring->size());
+    }
+
+    TEST(DeviceAllocator, DeferredTransfer) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+        SKIP_TEST(instance.device->unifiedMemory(), UNIFIED_MEMORY);
+
+        auto allocator = std::make_shared<vulkan::DeviceAllocator>(instance.device, vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+        auto info = allocator->allocate(4 * sizeof(size_t), vk::BufferUsageFlagBits::eVertexBuffer);
+        allocator->setTransferMode(vulkan::TransferMode::eDeferred);
+
+        // Update
+        for (size_t i = 0; i < 4; i++) {
+            static_cast<size_t*>(*info.ptr)[i] = i;
+            allocator->invalidate(info, i * sizeof(size_t), sizeof(size_t));
+        }
+
+        // Assert
+        auto fence = allocator->flush();
+        ASSERT_TRUE(fence);
+        fence.wait();
+        ASSERT_FALSE(allocator->flush());
+    }
+
+    TEST(DeviceAllocator, CopyAfterFreeHost) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+        SKIP_TEST(instance.device->unifiedMemory(), UNIFIED_MEMORY);
+
+        auto allocator = std::make_shared<vulkan::DeviceAllocator>(instance.device, vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+        auto first = allocator->allocate(4 * sizeof(size_t), vk::BufferUsageFlagBits::eVertexBuffer);
+        auto second = allocator->allocate(4 * sizeof(size_t), vk::BufferUsageFlagBits::eVertexBuffer);
+
+        // Update
+        for (size_t i = 0; i < 4; i++) {
+            static_cast<size_t*>(*first.ptr)[i] = i;
+        }
+        allocator->invalidate(first, 0, 4 * sizeof(size_t));
+
+        // Assert copy doesn't read through first's stale pointer
+        allocator->freeHost(first);
+        ASSERT_NO_THROW(allocator->copy(first, second, 4 * sizeof(size_t)));
+        ASSERT_THROW(allocator->copy(first, second, 8 * sizeof(size_t)), core::Exception);
+    }
+
+    TEST(DeviceAllocator, UnifiedMemory) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+        SKIP_TEST(!instance.device->unifiedMemory(), DISCRETE_MEMORY);
+
+        auto allocator = std::make_shared<vulkan::DeviceAllocator>(instance.device, vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+        auto first = allocator->allocate(4 * sizeof(size_t), vk::BufferUsageFlagBits::eVertexBuffer);
+        auto second = allocator->allocate(4 * sizeof(size_t), vk::BufferUsageFlagBits::eVertexBuffer);
+
+        // Assert no host buffer
+        ASSERT_TRUE(first.ptr);
         ASSERT_EQ(0, allocator->sizeOnHost());
+
+        // Update & copy
+        for (size_t i = 0; i < 4; i++) {
+            static_cast<size_t*>(*first.ptr)[i] = i;
+        }
+        allocator->invalidate(first, 0, 4 * sizeof(size_t));
+        allocator->copy(first, second, 4 * sizeof(size_t));
+
+        // Assert nothing is transferred
+        ASSERT_FALSE(allocator->flush());
+        for (size_t i = 0; i < 4; i++) {
+            ASSERT_EQ(i, static_cast<size_t*>(*second.ptr)[i]);
+        }
+    }
+
+    TEST(LinearAllocator, Allocate) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<vulkan::LinearAllocator>(instance.device, 2, 1024);
+        auto first = allocator->allocate(sizeof(size_t), vk::BufferUsageFlagBits::eUniformBuffer);
+        auto second = allocator->allocate(sizeof(size_t), vk::BufferUsageFlagBits::eUniformBuffer);
+
+        // Assert
+        ASSERT_EQ(first.buffer, second.buffer);
+        ASSERT_EQ(first.offset + first.size, second.offset);
+        ASSERT_EQ(first.size + second.size, allocator->size());
+        ASSERT_THROW(allocator->allocate(2048, vk::BufferUsageFlagBits::eUniformBuffer), core::Exception);
+        ASSERT_EQ(first.size + second.size, allocator->size());
+        ASSERT_EQ(2, allocator->statistics().allocations);
+        ASSERT_EQ(first.size + second.size, allocator->statistics().allocated);
+
+        // Next frame
+        allocator->reset(1);
+        auto third = allocator->allocate(sizeof(size_t), vk::BufferUsageFlagBits::eUniformBuffer);
+
+        // Assert
+        ASSERT_NE(first.buffer, third.buffer);
+        ASSERT_EQ(0, third.offset);
+        ASSERT_TRUE(allocator->own(first));
+        ASSERT_TRUE(allocator->own(third));
+        ASSERT_EQ(3, allocator->statistics().allocations);
+
+        // Release first frame
+        allocator->reset(0);
+
+        // Assert
+        ASSERT_EQ(1, allocator->statistics().allocations);
+        ASSERT_EQ(third.size, allocator->statistics().allocated);
+    }
+
+    TEST(HostAllocator, Budget) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<vulkan::HostAllocator>(instance.device, 0, 1024);
+        std::optional<u32> over_budget_heap;
+        allocator->setOverBudgetCallback([&over_budget_heap](u32 heap, vulkan::Allocator::HeapBudget budget) { over_budget_heap = heap; });
+
+        auto info = allocator->allocate(sizeof(size_t), vk::BufferUsageFlagBits::eUniformBuffer);
+        auto properties = instance.device->physical().getMemoryProperties();
+
+        // Assert
+        vk::DeviceSize usage = 0;
+        for (u32 heap = 0; heap < properties.memoryHeapCount; heap++) {
+            usage += allocator->heapUsage(heap);
+            ASSERT_LE(allocator->heapUsage(heap), properties.memoryHeaps[heap].size);
+        }
+        ASSERT_GE(usage, 1024);
+        ASSERT_FALSE(over_budget_heap);
+
+        allocator->free(info);
+
+        // Assert
+        ASSERT_EQ(0, allocator->size());
+    }
+
+    TEST(HostAllocator, MemoryBudget) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+        SKIP_TEST(!instance.device->extensionEnabled(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME), MEMORY_BUDGET_UNSUPPORTED);
+
+        auto allocator = std::make_shared<vulkan::HostAllocator>(instance.device, 0, 1024);
+        auto info = allocator->allocate(sizeof(size_t), vk::BufferUsageFlagBits::eUniformBuffer);
+        auto properties = instance.device->physical().getMemoryProperties();
+
+        // Assert usage is process-wide, so it includes allocator's usage
+        for (u32 heap = 0; heap < properties.memoryHeapCount; heap++) {
+            auto budget = allocator->budget(heap);
+
+            ASSERT_GE(budget.usage, allocator->heapUsage(heap));
+            ASSERT_LE(budget.budget, properties.memoryHeaps[heap].size);
+        }
+
+        allocator->free(info);
+    }
+
+    TEST(HostAllocator, FallbackBudget) {
+        // Init instance (without VK_EXT_memory_budget)
+        VkInstance instance;
+        SKIP_TEST(!instance.init(true, false), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<vulkan::HostAllocator>(instance.device, 0, 1024);
+        auto info = allocator->allocate(sizeof(size_t), vk::BufferUsageFlagBits::eUniformBuffer);
+        auto properties = instance.device->physical().getMemoryProperties();
+
+        // Assert usage is allocator's usage and budget is 80% of heap
+        ASSERT_FALSE(instance.device->extensionEnabled(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME));
+        for (u32 heap = 0; heap < properties.memoryHeapCount; heap++) {
+            auto budget = allocator->budget(heap);
+
+            ASSERT_EQ(allocator->heapUsage(heap), budget.usage);
+            ASSERT_EQ(properties.memoryHeaps[heap].size * 8 / 10, budget.budget);
+        }
+
+        allocator->free(info);
+    }
+
+    /**
+     * @brief HostAllocator whose heap usage can be raised, so that a heap exceeds its budget
+     *
+     */
+    class OverBudgetAllocator : public vulkan::HostAllocator {
+       public:
+        using vulkan::HostAllocator::HostAllocator;
+        using vulkan::HostAllocator::track;
+        using vulkan::HostAllocator::untrack;
+    };
+
+    TEST(HostAllocator, OverBudgetEviction) {
+        // Init instance (without VK_EXT_memory_budget, so usage is allocator's usage)
+        VkInstance instance;
+        SKIP_TEST(!instance.init(true, false), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<OverBudgetAllocator>(instance.device, 0, 1024);
+        auto evicted = allocator->allocate(sizeof(size_t), vk::BufferUsageFlagBits::eUniformBuffer);
+        auto properties = instance.device->physical().getMemoryProperties();
+
+        // Fill heap of allocator's blocks
+        u32 memory_type = allocator->statistics().memory_types.begin()->first;
+        u32 heap = properties.memoryTypes[memory_type].heapIndex;
+        allocator->track(memory_type, properties.memoryHeaps[heap].size);
+
+        // Callback frees an allocation (it would deadlock if pool's lock was held)
+        std::optional<u32> over_budget_heap;
+        allocator->setOverBudgetCallback(
+            [&over_budget_heap, &evicted, allocator = allocator.get()](u32 index, [[maybe_unused]] vulkan::Allocator::HeapBudget budget) {
+                over_budget_heap = index;
+                if (allocator->own(evicted)) {
+                    allocator->free(evicted);
+                }
+            });
+        auto info = allocator->allocate(2048, vk::BufferUsageFlagBits::eUniformBuffer);
+
+        // Assert
+        ASSERT_EQ(heap, over_budget_heap);
+        ASSERT_FALSE(allocator->own(evicted));
+        ASSERT_TRUE(allocator->own(info));
+
+        allocator->untrack(memory_type, properties.memoryHeaps[heap].size);
+        allocator->free(info);
+    }
+
+    TEST(DeviceAllocator, Defragment) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+        SKIP_TEST(instance.device->unifiedMemory(), UNIFIED_MEMORY);
+
+        auto allocator = std::make_shared<vulkan::DeviceAllocator>(instance.device, vk::CommandBufferUsageFlagBits::eOneTimeSubmit, 0,
+                                                                   vulkan::DeviceAllocationStrategy::eTLSF, 1024);
+        auto first = allocator->allocate(512, vk::BufferUsageFlagBits::eVertexBuffer);
+        auto second = allocator->allocate(512, vk::BufferUsageFlagBits::eVertexBuffer);
+        auto third = allocator->allocate(512, vk::BufferUsageFlagBits::eVertexBuffer);
+        allocator->free(second);
+
+        // Assert
+        ASSERT_EQ(2, allocator->blockCount());
+
+        std::optional<std::pair<vk::Buffer, vk::DeviceSize>> relocation;
+        auto callback = [&relocation](vk::Buffer buffer, vk::DeviceSize offset) { relocation = std::make_pair(buffer, offset); };
+        allocator->setRelocationCallback(first, callback);
+        allocator->setRelocationCallback(third, callback);
+
+        // Defragment
+        auto fence = allocator->defragment(1024);
+        ASSERT_TRUE(fence);
+
+        // Update moved allocations, their transfers wait defragmentation's copies
+        allocator->invalidate(first, 0, first.size);
+        allocator->invalidate(third, 0, third.size);
+        fence.wait();
+
+        // Release moved ranges without another defragmentation
+        allocator->flush();
+
+        // Assert
+        ASSERT_TRUE(relocation);
+        ASSERT_TRUE(allocator->own(first));
+        ASSERT_TRUE(allocator->own(third));
+        ASSERT_EQ(1, allocator->blockCount());
+    }
+
+    TEST(HostAllocator, DedicatedThreshold) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<vulkan::HostAllocator>(instance.device, 0, 1024);
+        allocator->setDedicatedThreshold(256);
+        auto small = allocator->allocate(64, vk::BufferUsageFlagBits::eUniformBuffer);
+        auto big = allocator->allocate(512, vk::BufferUsageFlagBits::eUniformBuffer);
+
+        // Assert
+        ASSERT_EQ(2, allocator->blockCount());
+        ASSERT_NE(small.buffer, big.buffer);
+
+        allocator->free(big);
+
+        // Assert dedicated block is released
+        ASSERT_EQ(1, allocator->blockCount());
+    }
+
+    TEST(Allocator, Coherent) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto linear_allocator = std::make_shared<vulkan::LinearAllocator>(instance.device, 1, 1024);
+        auto device_allocator = std::make_shared<vulkan::DeviceAllocator>(instance.device, vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+        auto linear = linear_allocator->allocate(64, vk::BufferUsageFlagBits::eUniformBuffer);
+        auto device = device_allocator->allocate(64, vk::BufferUsageFlagBits::eUniformBuffer);
+
+        // Assert (device allocations must be transferred)
+        ASSERT_TRUE(linear.coherent);
+        ASSERT_FALSE(device.coherent);
+
+        device_allocator->free(device);
+    }
+
+    TEST(HostAllocator, Statistics) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<vulkan::HostAllocator>(instance.device, 0, 4096);
+        auto first = allocator->allocate(64, vk::BufferUsageFlagBits::eUniformBuffer);
+        auto second = allocator->allocate(1024, vk::BufferUsageFlagBits::eUniformBuffer);
+        auto statistics = allocator->statistics();
+
+        // Assert
+        ASSERT_EQ(2, statistics.allocations);
+        ASSERT_EQ(first.size + second.size, statistics.allocated);
+        ASSERT_EQ(2, std::accumulate(statistics.histogram.begin(), statistics.histogram.end(), size_t(0)));
+        ASSERT_EQ(1, statistics.memory_types.size());
+
+        auto& type = statistics.memory_types.begin()->second;
+        ASSERT_EQ(1, type.blocks);
+        ASSERT_LE(first.size + second.size, type.used());
+        ASSERT_LE(type.largest_free, type.free);
+        ASSERT_NE(std::string::npos, allocator->dump().find("\"allocations\": 2"));
+
+        allocator->free(second);
+
+        // Assert
+        ASSERT_EQ(1, allocator->statistics().allocations);
     }
-}  // namespace ao::test
\ No newline at end of file
+}  // namespace ao::test
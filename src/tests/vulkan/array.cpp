@@ -139,7 +139,7 @@ namespace ao::test {
         // Assert
         ASSERT_NE(nullptr, array.info().buffer);
         ASSERT_TRUE(array.info().ptr);
-        ASSERT_EQ(core::utilities::calculateAligmentSize(10 * sizeof(Object), instance.minAligment()), array.info().size);
+        ASSERT_EQ(10 * allocator->alignSize(sizeof(Object)), array.info().size);
     }
 
     TEST(HostArray, Offset) {
@@ -151,7 +151,7 @@ namespace ao::test {
         vulkan::Array<10, Object> array(Object(15), allocator);
 
         // Assert
-        ASSERT_EQ(sizeof(Object) * 3, array.offset(3));
+        ASSERT_EQ(array.info().offset + sizeof(Object) * 3, array.offset(3));
     }
 
     TEST(DeviceArray, Offset) {
@@ -163,6 +163,78 @@ namespace ao::test {
         vulkan::Array<10, Object> array(Object(15), allocator);
 
         // Assert
-        ASSERT_EQ(sizeof(Object) * 3, array.offset(3));
+        ASSERT_EQ(array.info().offset + sizeof(Object) * 3, array.offset(3));
+    }
+
+    TEST(DeviceArray, BulkUpload) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<vulkan::DeviceAllocator>(instance.device, vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+        vulkan::Array<10, Object> array(allocator);
+        std::vector<Object> objects;
+        for (u64 i = 0; i < 4; i++) {
+            objects.push_back(Object(i));
+        }
+
+        array.fill(Object(15));
+        array.upload(objects.data(), objects.size(), 6);
+
+        // Assert content
+        for (size_t i = 0; i < array.size(); i++) {
+            ASSERT_EQ(i < 6 ? 15 : i - 6, array[i].i);
+        }
+
+        // Assert range is checked
+        ASSERT_THROW(array.upload(objects.data(), objects.size(), 7), core::Exception);
+    }
+
+    TEST(DeviceArray, BulkConstructor) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<vulkan::DeviceAllocator>(instance.device, vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+        std::vector<Object> objects;
+        for (u64 i = 0; i < 10; i++) {
+            objects.push_back(Object(i));
+        }
+
+        vulkan::Array<10, Object> array(objects.data(), objects.size(), allocator);
+        vulkan::Array<10, Object> view_array(core::Span<Object const>(objects.data(), 4), allocator);
+
+        // Assert
+        for (size_t i = 0; i < array.size(); i++) {
+            ASSERT_EQ(i, array[i].i);
+        }
+        for (size_t i = 0; i < 4; i++) {
+            ASSERT_EQ(i, view_array[i].i);
+        }
+        ASSERT_THROW((vulkan::Array<2, Object>(objects.data(), objects.size(), allocator)), core::Exception);
+    }
+
+    TEST(HostArray, Span) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<vulkan::HostAllocator>(instance.device);
+        vulkan::Array<10, u64> array(0, allocator);
+
+        // Write through view
+        auto view = array.span<u64>();
+        for (size_t i = 0; i < 10; i++) {
+            view[i] = i;
+        }
+        array.invalidate(0, 10);
+
+        // Assert
+        ASSERT_LE(10, view.size());
+        ASSERT_EQ(5, view.subspan(5, 2)[0]);
+        for (size_t i = 0; i < 10; i++) {
+            ASSERT_EQ(i, array[i]);
+        }
+        ASSERT_THROW(view.subspan(view.size(), 1), std::out_of_range);
     }
 }  // namespace ao::test
@@ -0,0 +1,51 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include <ao/vulkan/utilities/device.h>
+#include <ao/vulkan/wrapper/device.h>
+#include <gtest/gtest.h>
+#include <boost/log/core.hpp>
+#include <boost/log/expressions.hpp>
+#include <boost/log/trivial.hpp>
+
+#include "../helpers/tests.h"
+#include "../helpers/vk_instance.hpp"
+
+namespace ao::test {
+    TEST(Device, MemoryType) {
+        // 'Mute' logger
+        core::Logger::Init();
+        boost::log::core::get()->set_filter(boost::log::trivial::severity >= boost::log::trivial::fatal);
+
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto& properties = instance.device->memoryProperties();
+        auto host_visible = instance.device->memoryType(~0u, vk::MemoryPropertyFlagBits::eHostVisible);
+
+        // Assert
+        ASSERT_EQ(vulkan::utilities::memoryType(instance.device->physical(), ~0u, vk::MemoryPropertyFlagBits::eHostVisible), host_visible);
+        ASSERT_TRUE(properties.memoryTypes[host_visible].propertyFlags & vk::MemoryPropertyFlagBits::eHostVisible);
+        ASSERT_THROW(instance.device->memoryType(0, vk::MemoryPropertyFlagBits::eHostVisible), core::Exception);
+    }
+
+    TEST(Device, PreferredMemoryType) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto& properties = instance.device->memoryProperties();
+        auto type = instance.device->memoryType(~0u, vk::MemoryPropertyFlagBits::eHostVisible, vk::MemoryPropertyFlagBits::eDeviceLocal);
+
+        // Assert preferred flags are picked when a type has them
+        vk::MemoryPropertyFlags flags = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eDeviceLocal;
+        bool exists = false;
+        for (u32 i = 0; i < properties.memoryTypeCount; i++) {
+            exists |= (properties.memoryTypes[i].propertyFlags & flags) == flags;
+        }
+        ASSERT_TRUE(properties.memoryTypes[type].propertyFlags & vk::MemoryPropertyFlagBits::eHostVisible);
+        ASSERT_EQ(exists, static_cast<bool>(properties.memoryTypes[type].propertyFlags & vk::MemoryPropertyFlagBits::eDeviceLocal));
+    }
+}  // namespace ao::test
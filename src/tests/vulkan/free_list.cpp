@@ -0,0 +1,91 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include <ao/vulkan/exception/unknown_allocation.h>
+#include <ao/vulkan/memory/allocator/free_list.h>
+#include <gtest/gtest.h>
+
+#include "../helpers/tests.h"
+
+namespace ao::test {
+    TEST(FreeList, Allocate) {
+        vulkan::FreeList list(1024);
+
+        auto first = list.allocate(256, 256);
+        auto second = list.allocate(256, 256);
+
+        // Assert
+        ASSERT_TRUE(first);
+        ASSERT_TRUE(second);
+        ASSERT_EQ(0, *first);
+        ASSERT_EQ(256, *second);
+        ASSERT_EQ(512, list.used());
+    }
+
+    TEST(FreeList, Alignment) {
+        vulkan::FreeList list(1024);
+
+        list.allocate(16, 16);
+        auto aligned = list.allocate(64, 256);
+
+        // Assert
+        ASSERT_TRUE(aligned);
+        ASSERT_EQ(256, *aligned);
+
+        // Padding is still usable
+        auto padding = list.allocate(16, 16);
+        ASSERT_TRUE(padding);
+        ASSERT_EQ(16, *padding);
+    }
+
+    TEST(FreeList, Full) {
+        vulkan::FreeList list(512);
+
+        list.allocate(512, 1);
+
+        // Assert
+        ASSERT_FALSE(list.allocate(1, 1));
+    }
+
+    TEST(FreeList, Coalesce) {
+        vulkan::FreeList list(768);
+
+        auto a = list.allocate(256, 1);
+        auto b = list.allocate(256, 1);
+        auto c = list.allocate(256, 1);
+
+        list.free(*a);
+        list.free(*c);
+        list.free(*b);
+
+        // Assert
+        ASSERT_TRUE(list.empty());
+        auto whole = list.allocate(768, 1);
+        ASSERT_TRUE(whole);
+        ASSERT_EQ(0, *whole);
+    }
+
+    TEST(FreeList, ZeroSize) {
+        vulkan::FreeList list(512);
+
+        auto first = list.allocate(0, 1);
+        auto second = list.allocate(0, 1);
+
+        // Assert
+        ASSERT_TRUE(first);
+        ASSERT_TRUE(second);
+        ASSERT_NE(*first, *second);
+
+        list.free(*first);
+        list.free(*second);
+        ASSERT_TRUE(list.empty());
+    }
+
+    TEST(FreeList, FreeUnknown) {
+        vulkan::FreeList list(512);
+
+        // Assert
+        ASSERT_EXCEPTION<vulkan::UnknownAllocation>([&]() { list.free(64); });
+    }
+}  // namespace ao::test
@@ -0,0 +1,194 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include <ao/vulkan/engine/headless_engine.h>
+#include <gtest/gtest.h>
+#include <boost/log/core.hpp>
+#include <boost/log/expressions.hpp>
+#include <boost/log/trivial.hpp>
+
+#include "../helpers/tests.h"
+#include "../helpers/vk_instance.hpp"
+
+namespace ao::test {
+    /**
+     * @brief Headless engine clearing its frames in red
+     *
+     */
+    class ClearEngine : public vulkan::HeadlessEngine {
+       public:
+        std::vector<u8> pixels;
+        size_t frames;
+
+        explicit ClearEngine(std::shared_ptr<vulkan::EngineSettings> settings) : vulkan::HeadlessEngine(settings), frames(0) {}
+
+       protected:
+        vk::RenderPass createRenderPass() override {
+            vk::AttachmentDescription color(vk::AttachmentDescriptionFlags(), vulkan::OffscreenSwapchain::ColorFormat, vk::SampleCountFlagBits::e1,
+                                            vk::AttachmentLoadOp::eClear, vk::AttachmentStoreOp::eStore, vk::AttachmentLoadOp::eDontCare,
+                                            vk::AttachmentStoreOp::eDontCare, vk::ImageLayout::eUndefined, vulkan::OffscreenSwapchain::FinalLayout);
+            vk::AttachmentReference reference(0, vk::ImageLayout::eColorAttachmentOptimal);
+            vk::SubpassDescription subpass(vk::SubpassDescriptionFlags(), vk::PipelineBindPoint::eGraphics, 0, nullptr, 1, &reference);
+
+            return this->device->logical()->createRenderPass(vk::RenderPassCreateInfo(vk::RenderPassCreateFlags(), 1, &color, 1, &subpass));
+        }
+
+        void createVulkanObjects() override {}
+
+        void updateCommandBuffers() override {
+            auto& command = this->swapchain->currentCommand();
+            vk::ClearValue clear(vk::ClearColorValue(std::array<float, 4>{1.0f, 0.0f, 0.0f, 1.0f}));
+
+            command.begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+            command.beginRenderPass(vk::RenderPassBeginInfo(this->render_pass, this->swapchain->currentFrame(),
+                                                            vk::Rect2D(vk::Offset2D(), this->swapchain->extent()), 1, &clear),
+                                    vk::SubpassContents::eInline);
+            command.endRenderPass();
+            command.end();
+        }
+
+        void beforeCommandBuffersUpdate() override {}
+
+        void afterFrame() override {
+            if (++this->frames == 5) {
+                this->pixels = this->readFrame();
+            }
+        }
+
+        bool loopingCondition() const override {
+            return this->frames < 5;
+        }
+    };
+
+    /**
+     * @brief ClearEngine recording its draws with the command recorder
+     *
+     */
+    class ParallelClearEngine : public ClearEngine {
+       public:
+        std::atomic<size_t> draws;
+
+        explicit ParallelClearEngine(std::shared_ptr<vulkan::EngineSettings> settings) : ClearEngine(settings), draws(0) {}
+
+       protected:
+        void updateCommandBuffers() override {
+            vk::ClearValue clear(vk::ClearColorValue(std::array<float, 4>{1.0f, 0.0f, 0.0f, 1.0f}));
+
+            this->recordParallel(vk::RenderPassBeginInfo(this->render_pass, this->swapchain->currentFrame(),
+                                                         vk::Rect2D(vk::Offset2D(), this->swapchain->extent()), 1, &clear),
+                                 1000, [this](vk::CommandBuffer command, size_t begin, size_t end) { this->draws += end - begin; });
+        }
+    };
+
+    /**
+     * @brief ClearEngine keeping values of its timeline semaphore once last frame is read
+     *
+     */
+    class TimelineClearEngine : public ClearEngine {
+       public:
+        std::optional<u64> target;
+        u64 value;
+
+        explicit TimelineClearEngine(std::shared_ptr<vulkan::EngineSettings> settings) : ClearEngine(settings), value(0) {}
+
+       protected:
+        void afterFrame() override {
+            ClearEngine::afterFrame();
+
+            if (this->frames == 5 && this->graphicsTimeline()) {
+                this->target = this->graphicsTimeline()->target();
+                this->value = this->graphicsTimeline()->value();
+            }
+        }
+    };
+
+    /**
+     * @brief Mute logger and check that vulkan can be initialized
+     *
+     * @return true Vulkan is supported
+     * @return false Vulkan isn't supported
+     */
+    inline bool vulkanSupported() {
+        core::Logger::Init();
+        boost::log::core::get()->set_filter(boost::log::trivial::severity >= boost::log::trivial::fatal);
+
+        VkInstance instance;
+        return instance.init();
+    }
+
+    /**
+     * @brief Create settings of a 16x8 surface
+     *
+     * @return std::shared_ptr<vulkan::EngineSettings> Settings
+     */
+    inline std::shared_ptr<vulkan::EngineSettings> surfaceSettings() {
+        auto settings = std::make_shared<vulkan::EngineSettings>();
+        settings->get<u32>(vulkan::settings::SurfaceWidth) = 16;
+        settings->get<u32>(vulkan::settings::SurfaceHeight) = 8;
+
+        return settings;
+    }
+
+    /**
+     * @brief Expect a 16x8 RGBA frame cleared in red
+     *
+     * @param pixels Pixels
+     */
+    inline void expectRed(std::vector<u8> const& pixels) {
+        ASSERT_EQ(16 * 8 * 4, pixels.size());
+        for (size_t i = 0; i < pixels.size(); i += 4) {
+            ASSERT_EQ((std::vector<u8>{255, 0, 0, 255}), std::vector<u8>(pixels.begin() + i, pixels.begin() + i + 4)) << "Pixel " << i / 4;
+        }
+    }
+
+    TEST(HeadlessEngine, Render) {
+        SKIP_TEST(!vulkanSupported(), VULKAN_INIT_FAILURE);
+
+        // More frames in flight than images, so images are waited through their last frame's fence
+        auto settings = surfaceSettings();
+        settings->get<u32>(vulkan::settings::HeadlessImages) = 2;
+        settings->get<u32>(vulkan::settings::FramesInFlight) = 3;
+
+        ClearEngine engine(settings);
+        engine.run();
+
+        // Assert
+        ASSERT_EQ(5, engine.frames);
+        expectRed(engine.pixels);
+    }
+
+    TEST(HeadlessEngine, ParallelRecording) {
+        SKIP_TEST(!vulkanSupported(), VULKAN_INIT_FAILURE);
+
+        auto settings = surfaceSettings();
+        settings->get<u32>(vulkan::settings::RecordingSlices) = 3;
+
+        ParallelClearEngine engine(settings);
+        engine.run();
+
+        // Assert
+        ASSERT_EQ(5 * 1000, engine.draws);
+        expectRed(engine.pixels);
+    }
+
+    TEST(HeadlessEngine, TimelineSemaphores) {
+        SKIP_TEST(!vulkanSupported(), VULKAN_INIT_FAILURE);
+
+        auto settings = surfaceSettings();
+        settings->get<u32>(vulkan::settings::HeadlessImages) = 2;
+        settings->get<bool>(vulkan::settings::TimelineSemaphores) = true;
+
+        // Engine falls back to fences when timeline semaphores aren't supported
+        TimelineClearEngine engine(settings);
+        engine.run();
+
+        // Assert
+        ASSERT_EQ(5, engine.frames);
+        expectRed(engine.pixels);
+        if (engine.target) {
+            ASSERT_EQ(5, *engine.target);
+            ASSERT_GE(engine.value, 5);
+        }
+    }
+}  // namespace ao::test
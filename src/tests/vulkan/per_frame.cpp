@@ -0,0 +1,60 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include <ao/core/utilities/types.h>
+#include <ao/vulkan/memory/allocator/host_allocator.h>
+#include <gtest/gtest.h>
+#include <ao/vulkan/memory/per_frame.hpp>
+#include <boost/log/core.hpp>
+#include <boost/log/expressions.hpp>
+#include <boost/log/trivial.hpp>
+
+#include "../helpers/tests.h"
+#include "../helpers/vk_instance.hpp"
+
+namespace ao::test {
+    struct Uniform {
+        u64 frame;
+    };
+
+    TEST(PerFrame, Rotate) {
+        // 'Mute' logger
+        core::Logger::Init();
+        boost::log::core::get()->set_filter(boost::log::trivial::severity >= boost::log::trivial::fatal);
+
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto alignment = instance.device->physical().getProperties().limits.minUniformBufferOffsetAlignment;
+        auto allocator = std::make_shared<vulkan::HostAllocator>(instance.device, alignment);
+        vulkan::PerFrame<Uniform> uniform(3, allocator);
+
+        for (size_t frame = 0; frame < 4; frame++) {
+            uniform.rotate(frame);
+            uniform->frame = frame;
+            uniform.invalidate();
+        }
+
+        // Assert
+        ASSERT_EQ(1, uniform.frame());
+        ASSERT_EQ(3, uniform[0].frame);
+        ASSERT_EQ(1, uniform[1].frame);
+        ASSERT_EQ(2, uniform[2].frame);
+        ASSERT_EQ(0, (uniform.dynamicOffset() % alignment));
+        ASSERT_EQ(uniform.relativeOffset(1), uniform.dynamicOffset());
+        ASSERT_EQ(uniform.info().offset + uniform.relativeOffset(1), uniform.offset(1));
+    }
+
+    TEST(PerFrame, NoFrame) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<vulkan::HostAllocator>(instance.device);
+
+        // Assert
+        ASSERT_THROW(vulkan::PerFrame<Uniform>(0, allocator), core::Exception);
+    }
+}  // namespace ao::test
@@ -0,0 +1,88 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include <ao/core/utilities/types.h>
+#include <ao/vulkan/memory/allocator/device_allocator.h>
+#include <ao/vulkan/memory/allocator/host_allocator.h>
+#include <gtest/gtest.h>
+#include <ao/vulkan/memory/soa_buffer.hpp>
+#include <boost/log/core.hpp>
+#include <boost/log/expressions.hpp>
+#include <boost/log/trivial.hpp>
+
+#include "../helpers/tests.h"
+#include "../helpers/vk_instance.hpp"
+
+namespace ao::test {
+    TEST(HostSoaBuffer, Columns) {
+        // 'Mute' logger
+        core::Logger::Init();
+        boost::log::core::get()->set_filter(boost::log::trivial::severity >= boost::log::trivial::fatal);
+
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto alignment = instance.device->physical().getProperties().limits.minStorageBufferOffsetAlignment;
+        auto allocator = std::make_shared<vulkan::HostAllocator>(instance.device, alignment);
+        vulkan::SoaBuffer<10, float, u64> buffer(allocator);
+
+        auto positions = buffer.column<0>();
+        auto ids = buffer.column<1>();
+        for (size_t i = 0; i < buffer.size(); i++) {
+            positions[i] = static_cast<float>(i);
+            ids[i] = i * 2;
+        }
+        buffer.invalidateColumn<0>();
+        buffer.invalidateColumn<1>();
+
+        // Assert layout
+        ASSERT_EQ(buffer.info().offset, buffer.offset<0>());
+        ASSERT_GE(buffer.offset<1>() - buffer.info().offset, 10 * sizeof(float));
+        ASSERT_EQ(0, ((buffer.offset<1>() - buffer.info().offset) % alignment));
+        ASSERT_EQ(0, ((buffer.offset<1>() - buffer.info().offset) % alignof(u64)));
+        ASSERT_EQ(buffer.offset<1>(), ids.offset());
+        ASSERT_EQ(10, ids.size());
+
+        // Assert content
+        for (size_t i = 0; i < buffer.size(); i++) {
+            ASSERT_EQ(static_cast<float>(i), buffer.column<0>()[i]);
+            ASSERT_EQ(i * 2, buffer.column<1>()[i]);
+        }
+    }
+
+    TEST(HostSoaBuffer, FieldAlignment) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<vulkan::HostAllocator>(instance.device);
+        vulkan::SoaBuffer<3, u8, u32, u64> buffer(allocator);
+
+        // Assert columns are packed on their field's alignment
+        ASSERT_EQ(4, buffer.offset<1>() - buffer.info().offset);
+        ASSERT_EQ(16, buffer.offset<2>() - buffer.info().offset);
+    }
+
+    TEST(DeviceSoaBuffer, DynamicSize) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<vulkan::DeviceAllocator>(instance.device, vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+        vulkan::SoaArray<u32, u64> buffer(100, allocator);
+
+        size_t i = 0;
+        for (auto& value : buffer.column<1>()) {
+            value = i++;
+        }
+        buffer.markDirty<1>(0, buffer.size());
+        buffer.flush();
+
+        // Assert
+        ASSERT_EQ(100, i);
+        ASSERT_EQ(99, buffer.column<1>()[99]);
+        ASSERT_FALSE(buffer.dirty());
+    }
+}  // namespace ao::test
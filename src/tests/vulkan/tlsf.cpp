@@ -0,0 +1,106 @@
+// Copyright 2018-2019 Astral-Ocean Project
+// Licensed under GPLv3 or any later version
+// Refer to the LICENSE.md file included.
+
+#include <map>
+#include <random>
+
+#include <ao/vulkan/exception/unknown_allocation.h>
+#include <ao/vulkan/memory/allocator/tlsf.h>
+#include <gtest/gtest.h>
+
+#include "../helpers/tests.h"
+
+namespace ao::test {
+    TEST(TLSF, Allocate) {
+        vulkan::TLSF tlsf(1024);
+
+        auto first = tlsf.allocate(256, 256);
+        auto second = tlsf.allocate(256, 256);
+
+        // Assert
+        ASSERT_TRUE(first);
+        ASSERT_TRUE(second);
+        ASSERT_NE(*first, *second);
+        ASSERT_EQ(0, *first % 256);
+        ASSERT_EQ(0, *second % 256);
+        ASSERT_EQ(512, tlsf.used());
+    }
+
+    TEST(TLSF, Full) {
+        vulkan::TLSF tlsf(512);
+
+        ASSERT_TRUE(tlsf.allocate(512, 1));
+
+        // Assert
+        ASSERT_FALSE(tlsf.allocate(1, 1));
+    }
+
+    TEST(TLSF, Coalesce) {
+        vulkan::TLSF tlsf(768);
+
+        auto a = tlsf.allocate(256, 1);
+        auto b = tlsf.allocate(256, 1);
+        auto c = tlsf.allocate(256, 1);
+
+        tlsf.free(*a);
+        tlsf.free(*c);
+        tlsf.free(*b);
+
+        // Assert
+        ASSERT_TRUE(tlsf.empty());
+        auto whole = tlsf.allocate(768, 1);
+        ASSERT_TRUE(whole);
+        ASSERT_EQ(0, *whole);
+    }
+
+    TEST(TLSF, FreeUnknown) {
+        vulkan::TLSF tlsf(512);
+
+        // Assert
+        ASSERT_EXCEPTION<vulkan::UnknownAllocation>([&]() { tlsf.free(64); });
+    }
+
+    TEST(TLSF, NoOverlap) {
+        std::map<vk::DeviceSize, vk::DeviceSize> ranges;
+        std::mt19937 generator(42);
+        vulkan::TLSF tlsf(1 << 20);
+
+        for (size_t i = 0; i < 10000; i++) {
+            if (ranges.empty() || generator() % 3 != 0) {
+                vk::DeviceSize size = 1 + generator() % 4096;
+                vk::DeviceSize alignment = vk::DeviceSize(1) << (generator() % 9);
+
+                if (auto offset = tlsf.allocate(size, alignment)) {
+                    ASSERT_EQ(0, *offset % alignment);
+                    ASSERT_LE(*offset + size, tlsf.size());
+
+                    // Check neighbours
+                    auto next = ranges.lower_bound(*offset);
+                    if (next != ranges.end()) {
+                        ASSERT_LE(*offset + size, next->first);
+                    }
+                    if (next != ranges.begin()) {
+                        auto previous = std::prev(next);
+                        ASSERT_LE(previous->first + previous->second, *offset);
+                    }
+                    ranges[*offset] = size;
+                }
+            } else {
+                auto it = std::next(ranges.begin(), generator() % ranges.size());
+
+                tlsf.free(it->first);
+                ranges.erase(it);
+            }
+        }
+
+        // Free everything
+        for (auto& [offset, size] : ranges) {
+            tlsf.free(offset);
+        }
+
+        // Assert
+        ASSERT_TRUE(tlsf.empty());
+        ASSERT_TRUE(tlsf.allocate(tlsf.size(), 1));
+    }
+}  // namespace ao::test
@@ -7,6 +7,7 @@
 #include <ao/vulkan/memory/allocator/device_allocator.h>
 #include <ao/vulkan/memory/allocator/host_allocator.h>
 #include <gtest/gtest.h>
+#include <ao/vulkan/memory/aligned_tuple.hpp>
 #include <ao/vulkan/memory/tuple.hpp>
 #include <boost/log/core.hpp>
 #include <boost/log/expressions.hpp>
@@ -57,7 +58,7 @@ namespace ao::test {
         // Assert
         ASSERT_NE(nullptr, tuple.info().buffer);
         ASSERT_TRUE(tuple.info().ptr);
-        ASSERT_EQ(core::utilities::calculateAligmentSize(vk::DeviceSize(sizeof(size_t) + sizeof(char*)), instance.minAligment()), tuple.info().size);
+        ASSERT_EQ(allocator->alignSize(sizeof(size_t)) + allocator->alignSize(sizeof(char*)), tuple.info().size);
     }
 
     TEST(HostTuple, Offset) {
@@ -69,8 +70,8 @@ namespace ao::test {
         vulkan::Tuple<size_t, char*> tuple(allocator);
 
         // Assert
-        ASSERT_EQ(vk::DeviceSize(0), tuple.offset(0));
-        ASSERT_EQ(vk::DeviceSize(sizeof(size_t)), tuple.offset(1));
+        ASSERT_EQ(tuple.info().offset, tuple.offset(0));
+        ASSERT_EQ(tuple.info().offset + sizeof(size_t), tuple.offset(1));
     }
 
     TEST(DeviceTuple, Offset) {
@@ -82,8 +83,8 @@ namespace ao::test {
         vulkan::Tuple<size_t, char*> tuple(allocator);
 
         // Assert
-        ASSERT_EQ(vk::DeviceSize(0), tuple.offset(0));
-        ASSERT_EQ(vk::DeviceSize(sizeof(size_t)), tuple.offset(1));
+        ASSERT_EQ(tuple.info().offset, tuple.offset(0));
+        ASSERT_EQ(tuple.info().offset + sizeof(size_t), tuple.offset(1));
     }
 
     TEST(HostTuple, UpdateAndGet) {
@@ -127,4 +128,25 @@ namespace ao::test {
             ASSERT_EQ(i, vulkan::get<1>(tuple)[i]);
         }
     }
-}  // namespace ao::test
\ No newline at end of file
+
+    TEST(AlignedTuple, Offsets) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<vulkan::HostAllocator>(instance.device);
+        vulkan::AlignedTuple<256, u32, u64> tuple(allocator);
+
+        static_assert(vulkan::AlignedTuple<256, u32, u64>::relativeOffset(1) == 256);
+        ASSERT_EQ(tuple.info().offset + 256, tuple.offset(1));
+
+        vulkan::get<0>(tuple) = 1;
+        vulkan::get<1>(tuple) = 2;
+        tuple.invalidate(0, 2);
+
+        // Assert
+        ASSERT_EQ(512, tuple.info().size);
+        ASSERT_EQ(1, vulkan::get<0>(tuple));
+        ASSERT_EQ(2, vulkan::get<1>(tuple));
+    }
+}  // namespace ao::test
@@ -22,6 +22,52 @@ namespace ao::test {
         explicit Object(u64 _i) : i(_i) {}
     };
 
+    /**
+     * @brief Read {count} objects of a device buffer with a GPU copy into host-visible memory
+     *
+     * @param instance Instance
+     * @param info Buffer info
+     * @param count Count of objects
+     * @return std::vector<u64> Values
+     */
+    std::vector<u64> readBack(VkInstance& instance, vulkan::Allocator::BufferInfo const& info, size_t count) {
+        auto logical = instance.device->logical();
+        vk::DeviceSize size = count * sizeof(Object);
+
+        // Create host-visible buffer
+        auto buffer = logical->createBuffer(vk::BufferCreateInfo(vk::BufferCreateFlags(), size, vk::BufferUsageFlagBits::eTransferDst));
+        auto mem_requirements = logical->getBufferMemoryRequirements(buffer);
+        auto memory = logical->allocateMemory(vk::MemoryAllocateInfo(
+            mem_requirements.size, instance.device->memoryType(mem_requirements.memoryTypeBits, vk::MemoryPropertyFlagBits::eHostVisible |
+                                                                                                     vk::MemoryPropertyFlagBits::eHostCoherent)));
+        logical->bindBufferMemory(buffer, memory, 0);
+
+        // Copy device buffer
+        auto command = instance.device->transferPool().allocateCommandBuffers(vk::CommandBufferLevel::ePrimary, 1).front();
+        command.begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+        command.copyBuffer(info.buffer, buffer, vk::BufferCopy(info.offset, 0, size));
+        command.end();
+
+        vulkan::Fence fence(logical);
+        instance.device->queues()->submit(vk::QueueFlagBits::eTransfer, vk::SubmitInfo().setCommandBufferCount(1).setPCommandBuffers(&command),
+                                          fence);
+        fence.wait();
+
+        // Read values
+        std::vector<u64> values(count);
+        auto data = static_cast<Object*>(logical->mapMemory(memory, 0, size));
+        for (size_t i = 0; i < count; i++) {
+            values[i] = data[i].i;
+        }
+        logical->unmapMemory(memory);
+
+        instance.device->transferPool().freeCommandBuffers(command);
+        fence.destroy();
+        logical->destroyBuffer(buffer);
+        logical->freeMemory(memory);
+        return values;
+    }
+
     TEST(HostVector, ValueConstructor) {
         // 'Mute' logger
         core::Logger::Init();
@@ -139,7 +185,7 @@ namespace ao::test {
         // Assert
         ASSERT_NE(nullptr, vector.info().buffer);
         ASSERT_TRUE(vector.info().ptr);
-        ASSERT_EQ(core::utilities::calculateAligmentSize(10 * sizeof(Object), instance.minAligment()), vector.info().size);
+        ASSERT_EQ(10 * allocator->alignSize(sizeof(Object)), vector.info().size);
     }
 
     TEST(HostVector, Offset) {
@@ -151,7 +197,7 @@ namespace ao::test {
         vulkan::Vector<Object> vector(10, Object(15), allocator);
 
         // Assert
-        ASSERT_EQ(sizeof(Object) * 3, vector.offset(3));
+        ASSERT_EQ(vector.info().offset + sizeof(Object) * 3, vector.offset(3));
     }
 
     TEST(DeviceVector, Offset) {
@@ -163,6 +209,142 @@ namespace ao::test {
         vulkan::Vector<Object> vector(10, Object(15), allocator);
 
         // Assert
-        ASSERT_EQ(sizeof(Object) * 3, vector.offset(3));
+        ASSERT_EQ(vector.info().offset + sizeof(Object) * 3, vector.offset(3));
+    }
+
+    TEST(HostVector, PushBack) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<vulkan::HostAllocator>(instance.device);
+        vulkan::Vector<Object> vector(0, allocator);
+
+        size_t reallocations = 0;
+        vector.setAfterRelocation([&reallocations](vulkan::Allocator::BufferInfo const& info) { reallocations++; });
+        for (u64 i = 0; i < 100; i++) {
+            vector.push_back(Object(i));
+        }
+
+        // Assert
+        ASSERT_EQ(100, vector.size());
+        ASSERT_GE(vector.capacity(), 100);
+        ASSERT_LE(reallocations, 7);
+        for (size_t i = 0; i < vector.size(); i++) {
+            ASSERT_EQ(i, vector[i].i);
+        }
+    }
+
+    TEST(DeviceVector, PushBack) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<vulkan::DeviceAllocator>(instance.device, vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+        vulkan::Vector<Object> vector(2, Object(15), allocator);
+
+        vector.emplace_back(3);
+        vector.invalidate(2);
+        vector.shrink_to_fit();
+
+        // Assert
+        ASSERT_EQ(3, vector.size());
+        ASSERT_EQ(3, vector.capacity());
+        ASSERT_TRUE(allocator->own(vector.info()));
+        ASSERT_EQ(15, vector[1].i);
+        ASSERT_EQ(3, vector[2].i);
+    }
+
+    TEST(DeviceVector, DirtyRanges) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<vulkan::DeviceAllocator>(instance.device, vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+        vulkan::Vector<Object> vector(10, Object(15), allocator);
+
+        vector[1].i = 1;
+        vector[2].i = 2;
+        vector[6].i = 6;
+        vector.markDirty(1);
+        vector.markDirty(2);
+        vector.markDirty(6);
+
+        // Assert
+        ASSERT_TRUE(vector.dirty());
+
+        vector.flush();
+
+        // Assert
+        ASSERT_FALSE(vector.dirty());
+        ASSERT_EQ(2, vector[2].i);
+    }
+
+    TEST(HostVector, Assign) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<vulkan::HostAllocator>(instance.device);
+        vulkan::Vector<Object> vector(2, Object(15), allocator);
+        std::vector<Object> objects;
+        for (u64 i = 0; i < 100; i++) {
+            objects.push_back(Object(i));
+        }
+
+        vector.assign(objects.data(), objects.size());
+
+        // Assert content
+        ASSERT_EQ(100, vector.size());
+        for (size_t i = 0; i < vector.size(); i++) {
+            ASSERT_EQ(i, vector[i].i);
+        }
+    }
+
+    TEST(DeviceVector, BulkConstructor) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<vulkan::DeviceAllocator>(instance.device, vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+        std::vector<Object> objects;
+        for (u64 i = 0; i < 100; i++) {
+            objects.push_back(Object(i));
+        }
+
+        vulkan::Vector<Object> vector(objects.data(), objects.size(), allocator);
+        vulkan::Vector<Object> view_vector(core::Span<Object const>(objects.data(), 10), allocator);
+
+        // Assert
+        ASSERT_EQ(100, vector.size());
+        ASSERT_EQ(10, view_vector.size());
+        for (size_t i = 0; i < vector.size(); i++) {
+            ASSERT_EQ(i, vector[i].i);
+        }
+        for (size_t i = 0; i < view_vector.size(); i++) {
+            ASSERT_EQ(i, view_vector[i].i);
+        }
+    }
+
+    TEST(DeviceVector, GrowKeepsDeviceData) {
+        // Init instance
+        VkInstance instance;
+        SKIP_TEST(!instance.init(), VULKAN_INIT_FAILURE);
+
+        auto allocator = std::make_shared<vulkan::DeviceAllocator>(instance.device, vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+        vulkan::Vector<Object> vector(4, Object(0), allocator);
+        for (size_t i = 0; i < vector.size(); i++) {
+            vector[i].i = i + 1;
+        }
+        vector.invalidate(0, vector.size());
+
+        // Grow (device data is copied by GPU)
+        vector.reserve(64);
+
+        // Assert
+        auto values = readBack(instance, vector.info(), 4);
+        for (size_t i = 0; i < values.size(); i++) {
+            ASSERT_EQ(i + 1, values[i]);
+        }
     }
 }  // namespace ao::test